@@ -0,0 +1,627 @@
+#ifndef PLAYGROUND_BPLUSTREE_HPP
+#define PLAYGROUND_BPLUSTREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Heap.hpp"
+
+// An ordered map from K to V, kept in a B+-tree: every node spans NODE_SIZE bytes (whole
+// cache lines), so it holds dozens of keys and the tree is only a few levels deep. The
+// entries are all in the leaves, which are linked into a list in key order, so a range
+// scan or an iteration streams through the arrays of consecutive leaves without going
+// back up the tree.
+//
+// As in BinarySearchTree, the nodes live in arenas (one for the leaves, one for the inner
+// nodes) and refer to each other by 32-bit indices; freed nodes are reused.
+//
+// Like the iterators of std::vector, the iterators are invalidated by insert and erase.
+// Dereferencing one gives a pair of references to the key and the value. Only operator<
+// is used on the keys, and both the keys and the values have to be default constructible.
+template<typename K, typename V, size_t NODE_SIZE = 256>
+class BPlusTree {
+private:
+    static_assert(NODE_SIZE >= 64 && NODE_SIZE % 64 == 0, "A node has to span whole cache lines.");
+
+    typedef uint32_t Index;
+    static constexpr Index nil = UINT32_MAX;
+
+    static constexpr size_t leaf_capacity = std::max<size_t>(4, (NODE_SIZE - 3 * sizeof(Index)) /
+                                                                (sizeof(K) + sizeof(V)));
+    static constexpr size_t inner_capacity = std::max<size_t>(4, (NODE_SIZE - sizeof(Index) + sizeof(K)) /
+                                                                 (sizeof(K) + sizeof(Index))); // children
+    static constexpr size_t min_leaf = leaf_capacity / 2;
+    static constexpr size_t min_inner = inner_capacity / 2;
+
+    struct alignas(64) Leaf {
+        Index count;
+        Index prev; // the leaves before and after in key order
+        Index next; // also the next free leaf once freed
+        K keys[leaf_capacity];
+        V values[leaf_capacity];
+    };
+
+    // keys[i] separates the keys of children[i] (less) from the ones of children[i + 1] (not less)
+    struct alignas(64) Inner {
+        Index count; // the number of children
+        K keys[inner_capacity - 1];
+        Index children[inner_capacity]; // children[0] is also the next free inner node once freed
+    };
+
+    std::vector<Leaf, CacheAlignedAllocator<Leaf>> leaves;
+    std::vector<Inner, CacheAlignedAllocator<Inner>> inners;
+    Index free_leaves;
+    Index free_inners;
+    Index root;
+    size_t height; // the number of inner levels, the root is a leaf if it's 0
+    Index first_leaf;
+    Index last_leaf;
+    size_t entry_count;
+    std::vector<std::pair<Index, size_t>> path; // the inner nodes and child slots followed by the last insert or erase
+
+    Index allocate_leaf() {
+        Index leaf;
+        if (free_leaves != nil) {
+            leaf = free_leaves;
+            free_leaves = leaves[leaf].next;
+        } else {
+            if (leaves.size() == nil)
+                throw std::length_error("Too many leaves in the B+-tree");
+            leaves.emplace_back();
+            leaf = leaves.size() - 1;
+        }
+        leaves[leaf].count = 0;
+        leaves[leaf].prev = nil;
+        leaves[leaf].next = nil;
+        return leaf;
+    }
+
+    void release_leaf(Index leaf) {
+        leaves[leaf].next = free_leaves;
+        free_leaves = leaf;
+    }
+
+    Index allocate_inner() {
+        Index inner;
+        if (free_inners != nil) {
+            inner = free_inners;
+            free_inners = inners[inner].children[0];
+        } else {
+            if (inners.size() == nil)
+                throw std::length_error("Too many inner nodes in the B+-tree");
+            inners.emplace_back();
+            inner = inners.size() - 1;
+        }
+        inners[inner].count = 0;
+        return inner;
+    }
+
+    void release_inner(Index inner) {
+        inners[inner].children[0] = free_inners;
+        free_inners = inner;
+    }
+
+    static size_t child_slot(const Inner& inner, const K& key) {
+        return std::upper_bound(inner.keys, inner.keys + inner.count - 1, key) - inner.keys;
+    }
+
+    static size_t key_slot(const Leaf& leaf, const K& key) {
+        return std::lower_bound(leaf.keys, leaf.keys + leaf.count, key) - leaf.keys;
+    }
+
+    // the leaf where key is or would be, recording the way down in path if asked to
+    Index find_leaf(const K& key, bool record_path) {
+        path.clear();
+        Index node = root;
+        for (size_t level = 0; level < height; level++) {
+            size_t slot = child_slot(inners[node], key);
+            if (record_path)
+                path.emplace_back(node, slot);
+            node = inners[node].children[slot];
+        }
+        return node;
+    }
+
+    Index find_leaf(const K& key) const {
+        Index node = root;
+        for (size_t level = 0; level < height; level++)
+            node = inners[node].children[child_slot(inners[node], key)];
+        return node;
+    }
+
+    // the position of the first entry whose key isn't less than key (or, if upper, is greater than it)
+    std::pair<Index, size_t> locate(const K& key, bool upper) const {
+        if (root == nil)
+            return {nil, 0};
+        Index leaf = find_leaf(key);
+        const Leaf& node = leaves[leaf];
+        size_t slot = upper ? std::upper_bound(node.keys, node.keys + node.count, key) - node.keys
+                            : key_slot(node, key);
+        if (slot == node.count)
+            return {node.next, 0};
+        return {leaf, slot};
+    }
+
+    void link_after(Index leaf, Index new_leaf) {
+        leaves[new_leaf].prev = leaf;
+        leaves[new_leaf].next = leaves[leaf].next;
+        if (leaves[leaf].next != nil)
+            leaves[leaves[leaf].next].prev = new_leaf;
+        else
+            last_leaf = new_leaf;
+        leaves[leaf].next = new_leaf;
+    }
+
+    void unlink(Index leaf) {
+        if (leaves[leaf].prev != nil)
+            leaves[leaves[leaf].prev].next = leaves[leaf].next;
+        else
+            first_leaf = leaves[leaf].next;
+        if (leaves[leaf].next != nil)
+            leaves[leaves[leaf].next].prev = leaves[leaf].prev;
+        else
+            last_leaf = leaves[leaf].prev;
+    }
+
+    static void insert_at(Leaf& leaf, size_t slot, const K& key, const V& value) {
+        std::move_backward(leaf.keys + slot, leaf.keys + leaf.count, leaf.keys + leaf.count + 1);
+        std::move_backward(leaf.values + slot, leaf.values + leaf.count, leaf.values + leaf.count + 1);
+        leaf.keys[slot] = key;
+        leaf.values[slot] = value;
+        leaf.count++;
+    }
+
+    static void remove_at(Leaf& leaf, size_t slot) {
+        std::move(leaf.keys + slot + 1, leaf.keys + leaf.count, leaf.keys + slot);
+        std::move(leaf.values + slot + 1, leaf.values + leaf.count, leaf.values + slot);
+        leaf.count--;
+    }
+
+    // moves the entries [from, count) of a leaf to the (empty) other one
+    static void move_tail(Leaf& leaf, size_t from, Leaf& other) {
+        std::move(leaf.keys + from, leaf.keys + leaf.count, other.keys);
+        std::move(leaf.values + from, leaf.values + leaf.count, other.values);
+        other.count = leaf.count - from;
+        leaf.count = from;
+    }
+
+    // the leaf split into itself and right, which is the first node of the split not yet in the parents
+    void insert_into_parents(K separator, Index right) {
+        while (!path.empty()) {
+            Index node = path.back().first;
+            size_t slot = path.back().second;
+            path.pop_back();
+
+            Inner& inner = inners[node];
+            if (inner.count < inner_capacity) {
+                std::move_backward(inner.keys + slot, inner.keys + inner.count - 1, inner.keys + inner.count);
+                std::move_backward(inner.children + slot + 1, inner.children + inner.count,
+                                   inner.children + inner.count + 1);
+                inner.keys[slot] = std::move(separator);
+                inner.children[slot + 1] = right;
+                inner.count++;
+                return;
+            }
+
+            // a full node: its children and the new one are divided between it and a new node
+            K keys[inner_capacity];
+            Index children[inner_capacity + 1];
+            std::move(inner.keys, inner.keys + slot, keys);
+            keys[slot] = std::move(separator);
+            std::move(inner.keys + slot, inner.keys + inner_capacity - 1, keys + slot + 1);
+            std::copy(inner.children, inner.children + slot + 1, children);
+            children[slot + 1] = right;
+            std::copy(inner.children + slot + 1, inner.children + inner_capacity, children + slot + 2);
+
+            size_t left_count = (inner_capacity + 1) / 2;
+            Index new_node = allocate_inner();
+            Inner& left = inners[node];
+            Inner& new_inner = inners[new_node];
+            std::move(keys, keys + left_count - 1, left.keys);
+            std::copy(children, children + left_count, left.children);
+            left.count = left_count;
+            std::move(keys + left_count, keys + inner_capacity, new_inner.keys);
+            std::copy(children + left_count, children + inner_capacity + 1, new_inner.children);
+            new_inner.count = inner_capacity + 1 - left_count;
+
+            separator = std::move(keys[left_count - 1]);
+            right = new_node;
+        }
+
+        Index new_root = allocate_inner();
+        inners[new_root].count = 2;
+        inners[new_root].keys[0] = std::move(separator);
+        inners[new_root].children[0] = root;
+        inners[new_root].children[1] = right;
+        root = new_root;
+        height++;
+    }
+
+    // removes keys[slot - 1] and children[slot]
+    static void remove_child(Inner& inner, size_t slot) {
+        std::move(inner.keys + slot, inner.keys + inner.count - 1, inner.keys + slot - 1);
+        std::copy(inner.children + slot + 1, inner.children + inner.count, inner.children + slot);
+        inner.count--;
+    }
+
+    // the leaf fell below the minimum: refills it from a sibling, or merges it into one
+    void fix_leaf(Index leaf) {
+        Inner& parent = inners[path.back().first];
+        size_t slot = path.back().second;
+        path.pop_back();
+        Leaf& node = leaves[leaf];
+
+        if (slot > 0 && leaves[parent.children[slot - 1]].count > min_leaf) {
+            Leaf& left = leaves[parent.children[slot - 1]];
+            insert_at(node, 0, left.keys[left.count - 1], left.values[left.count - 1]);
+            left.count--;
+            parent.keys[slot - 1] = node.keys[0];
+            return;
+        }
+        if (slot + 1 < parent.count && leaves[parent.children[slot + 1]].count > min_leaf) {
+            Leaf& right = leaves[parent.children[slot + 1]];
+            insert_at(node, node.count, right.keys[0], right.values[0]);
+            remove_at(right, 0);
+            parent.keys[slot] = right.keys[0];
+            return;
+        }
+
+        if (slot == 0)
+            slot++; // merging the right sibling into this one instead
+        Leaf& left = leaves[parent.children[slot - 1]];
+        Index right_leaf = parent.children[slot];
+        Leaf& right = leaves[right_leaf];
+        std::move(right.keys, right.keys + right.count, left.keys + left.count);
+        std::move(right.values, right.values + right.count, left.values + left.count);
+        left.count += right.count;
+        unlink(right_leaf);
+        release_leaf(right_leaf);
+        remove_child(parent, slot);
+
+        fix_inners();
+    }
+
+    // the inner node at the end of path may have fallen below the minimum, and so on upwards
+    void fix_inners() {
+        Index node = path.empty() ? root : inners[path.back().first].children[path.back().second];
+        while (true) {
+            Inner& inner = inners[node];
+            if (node == root) {
+                if (inner.count == 1) {
+                    root = inner.children[0];
+                    height--;
+                    release_inner(node);
+                }
+                return;
+            }
+            if (inner.count >= min_inner)
+                return;
+
+            Index parent_node = path.back().first;
+            Inner& parent = inners[parent_node];
+            size_t slot = path.back().second;
+            path.pop_back();
+
+            if (slot > 0 && inners[parent.children[slot - 1]].count > min_inner) {
+                Inner& left = inners[parent.children[slot - 1]];
+                std::move_backward(inner.keys, inner.keys + inner.count - 1, inner.keys + inner.count);
+                std::copy_backward(inner.children, inner.children + inner.count, inner.children + inner.count + 1);
+                inner.keys[0] = std::move(parent.keys[slot - 1]);
+                inner.children[0] = left.children[left.count - 1];
+                inner.count++;
+                parent.keys[slot - 1] = std::move(left.keys[left.count - 2]);
+                left.count--;
+                return;
+            }
+            if (slot + 1 < parent.count && inners[parent.children[slot + 1]].count > min_inner) {
+                Inner& right = inners[parent.children[slot + 1]];
+                inner.keys[inner.count - 1] = std::move(parent.keys[slot]);
+                inner.children[inner.count] = right.children[0];
+                inner.count++;
+                parent.keys[slot] = std::move(right.keys[0]);
+                std::move(right.keys + 1, right.keys + right.count - 1, right.keys);
+                std::copy(right.children + 1, right.children + right.count, right.children);
+                right.count--;
+                return;
+            }
+
+            if (slot == 0)
+                slot++;
+            Inner& left = inners[parent.children[slot - 1]];
+            Index right_node = parent.children[slot];
+            Inner& right = inners[right_node];
+            left.keys[left.count - 1] = std::move(parent.keys[slot - 1]);
+            std::move(right.keys, right.keys + right.count - 1, left.keys + left.count);
+            std::copy(right.children, right.children + right.count, left.children + left.count);
+            left.count += right.count;
+            release_inner(right_node);
+            remove_child(parent, slot);
+
+            node = parent_node;
+        }
+    }
+
+    // evens out the last two nodes of a level built by bulk loading, if the last one is too small
+    void balance_last_leaves() {
+        if (first_leaf == last_leaf || leaves[last_leaf].count >= min_leaf)
+            return;
+        Leaf& left = leaves[leaves[last_leaf].prev];
+        Leaf& right = leaves[last_leaf];
+        size_t moved = (left.count + right.count) / 2 - right.count;
+        std::move_backward(right.keys, right.keys + right.count, right.keys + right.count + moved);
+        std::move_backward(right.values, right.values + right.count, right.values + right.count + moved);
+        std::move(left.keys + left.count - moved, left.keys + left.count, right.keys);
+        std::move(left.values + left.count - moved, left.values + left.count, right.values);
+        left.count -= moved;
+        right.count += moved;
+    }
+
+    void bulk_load_inners() {
+        // the smallest key under each node of the level built last, and the node
+        std::vector<std::pair<K, Index>> level;
+        for (Index leaf = first_leaf; leaf != nil; leaf = leaves[leaf].next)
+            level.emplace_back(leaves[leaf].keys[0], leaf);
+
+        while (level.size() > 1) {
+            std::vector<size_t> group_sizes(level.size() / inner_capacity, inner_capacity);
+            size_t rest = level.size() % inner_capacity;
+            if (rest > 0)
+                group_sizes.push_back(rest);
+            if (group_sizes.size() > 1 && group_sizes.back() < min_inner) {
+                size_t total = inner_capacity + rest;
+                group_sizes[group_sizes.size() - 2] = total - total / 2;
+                group_sizes.back() = total / 2;
+            }
+
+            std::vector<std::pair<K, Index>> next_level;
+            size_t first = 0;
+            for (size_t group_size: group_sizes) {
+                Index node = allocate_inner();
+                Inner& inner = inners[node];
+                for (size_t idx = 0; idx < group_size; idx++) {
+                    inner.children[idx] = level[first + idx].second;
+                    if (idx > 0)
+                        inner.keys[idx - 1] = level[first + idx].first;
+                }
+                inner.count = group_size;
+                next_level.emplace_back(level[first].first, node);
+                first += group_size;
+            }
+            level = std::move(next_level);
+            height++;
+        }
+        root = level.empty() ? nil : level[0].second;
+    }
+
+public:
+    template<bool CONST>
+    class Iterator {
+    private:
+        friend class BPlusTree;
+        typedef typename std::conditional<CONST, const BPlusTree, BPlusTree>::type Tree;
+
+        Tree* tree;
+        Index leaf;
+        size_t slot;
+
+        Iterator(Tree* tree, Index leaf, size_t slot) : tree(tree), leaf(leaf), slot(slot) {}
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef std::pair<const K, V> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::pair<const K&, typename std::conditional<CONST, const V&, V&>::type> reference;
+
+        struct pointer {
+            reference entry;
+
+            reference* operator->() { return &entry; }
+        };
+
+        Iterator() : tree(nullptr), leaf(nil), slot(0) {}
+
+        template<bool OTHER, typename = typename std::enable_if<CONST && !OTHER>::type>
+        Iterator(const Iterator<OTHER>& other) : tree(other.tree), leaf(other.leaf), slot(other.slot) {}
+
+        const K& key() const { return tree->leaves[leaf].keys[slot]; }
+
+        typename std::conditional<CONST, const V&, V&>::type value() const { return tree->leaves[leaf].values[slot]; }
+
+        reference operator*() const { return reference(key(), value()); }
+
+        pointer operator->() const { return pointer{**this}; }
+
+        Iterator& operator++() {
+            if (++slot == tree->leaves[leaf].count) {
+                leaf = tree->leaves[leaf].next;
+                slot = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() {
+            if (leaf == nil) {
+                leaf = tree->last_leaf;
+                slot = tree->leaves[leaf].count - 1;
+            } else if (slot == 0) {
+                leaf = tree->leaves[leaf].prev;
+                slot = tree->leaves[leaf].count - 1;
+            } else {
+                slot--;
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return leaf == other.leaf && slot == other.slot; }
+
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+        template<bool>
+        friend class Iterator;
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    BPlusTree() : free_leaves(nil), free_inners(nil), root(nil), height(0), first_leaf(nil), last_leaf(nil),
+                  entry_count(0) {}
+
+    // bulk loading from (key, value) pairs sorted by key, with no key repeated: the leaves are
+    // filled one after the other, then the levels above them are built bottom up, in O(n)
+    template<typename ITERATOR>
+    BPlusTree(ITERATOR first, ITERATOR last) : BPlusTree() {
+        for (; first != last; ++first) {
+            if (last_leaf != nil && !(leaves[last_leaf].keys[leaves[last_leaf].count - 1] < first->first))
+                throw std::runtime_error("The keys of a bulk load have to be sorted and unique");
+            if (last_leaf == nil || leaves[last_leaf].count == leaf_capacity) {
+                Index leaf = allocate_leaf();
+                if (last_leaf == nil)
+                    first_leaf = last_leaf = leaf;
+                else
+                    link_after(last_leaf, leaf);
+            }
+            Leaf& leaf = leaves[last_leaf];
+            leaf.keys[leaf.count] = first->first;
+            leaf.values[leaf.count] = first->second;
+            leaf.count++;
+            entry_count++;
+        }
+        balance_last_leaves();
+        bulk_load_inners();
+    }
+
+    size_t size() const { return entry_count; }
+
+    bool empty() const { return entry_count == 0; }
+
+    // returns false (leaving the value as it was) if the key is already there
+    bool insert(const K& key, const V& value) {
+        if (root == nil)
+            root = first_leaf = last_leaf = allocate_leaf();
+
+        Index leaf = find_leaf(key, true);
+        size_t slot = key_slot(leaves[leaf], key);
+        if (slot < leaves[leaf].count && !(key < leaves[leaf].keys[slot]))
+            return false;
+        entry_count++;
+
+        if (leaves[leaf].count < leaf_capacity) {
+            insert_at(leaves[leaf], slot, key, value);
+            return true;
+        }
+
+        // a full leaf: the upper half of the entries go to a new leaf
+        size_t left_count = (leaf_capacity + 1) / 2;
+        Index new_leaf = allocate_leaf();
+        Leaf& left = leaves[leaf];
+        Leaf& right = leaves[new_leaf];
+        if (slot < left_count) {
+            move_tail(left, left_count - 1, right);
+            insert_at(left, slot, key, value);
+        } else {
+            move_tail(left, left_count, right);
+            insert_at(right, slot - left_count, key, value);
+        }
+        link_after(leaf, new_leaf);
+        insert_into_parents(right.keys[0], new_leaf);
+        return true;
+    }
+
+    // returns false if the key wasn't there
+    bool erase(const K& key) {
+        if (root == nil)
+            return false;
+
+        Index leaf = find_leaf(key, true);
+        Leaf& node = leaves[leaf];
+        size_t slot = key_slot(node, key);
+        if (slot == node.count || key < node.keys[slot])
+            return false;
+        remove_at(node, slot);
+        entry_count--;
+
+        if (height == 0) {
+            if (node.count == 0) {
+                release_leaf(leaf);
+                root = first_leaf = last_leaf = nil;
+            }
+        } else if (node.count < min_leaf) {
+            fix_leaf(leaf);
+        }
+        return true;
+    }
+
+    iterator begin() { return iterator(this, first_leaf, 0); }
+
+    iterator end() { return iterator(this, nil, 0); }
+
+    const_iterator begin() const { return const_iterator(this, first_leaf, 0); }
+
+    const_iterator end() const { return const_iterator(this, nil, 0); }
+
+    iterator lower_bound(const K& key) {
+        std::pair<Index, size_t> position = locate(key, false);
+        return iterator(this, position.first, position.second);
+    }
+
+    const_iterator lower_bound(const K& key) const {
+        std::pair<Index, size_t> position = locate(key, false);
+        return const_iterator(this, position.first, position.second);
+    }
+
+    iterator upper_bound(const K& key) {
+        std::pair<Index, size_t> position = locate(key, true);
+        return iterator(this, position.first, position.second);
+    }
+
+    const_iterator upper_bound(const K& key) const {
+        std::pair<Index, size_t> position = locate(key, true);
+        return const_iterator(this, position.first, position.second);
+    }
+
+    iterator find(const K& key) {
+        iterator found = lower_bound(key);
+        return found != end() && !(key < found.key()) ? found : end();
+    }
+
+    const_iterator find(const K& key) const {
+        const_iterator found = lower_bound(key);
+        return found != end() && !(key < found.key()) ? found : end();
+    }
+
+    bool contains(const K& key) const { return find(key) != end(); }
+
+    // calls f(key, value) on the entries with keys in [first, last), in order, leaf by leaf
+    template<typename F>
+    void scan(const K& first, const K& last, F&& f) const {
+        std::pair<Index, size_t> position = locate(first, false);
+        for (Index leaf = position.first; leaf != nil; leaf = leaves[leaf].next) {
+            const Leaf& node = leaves[leaf];
+            bool last_leaf_of_range = !(node.keys[node.count - 1] < last);
+            size_t end = last_leaf_of_range ? key_slot(node, last) : node.count;
+            for (size_t slot = leaf == position.first ? position.second : 0; slot < end; slot++)
+                f(node.keys[slot], node.values[slot]);
+            if (last_leaf_of_range)
+                return;
+        }
+    }
+};
+
+#endif //PLAYGROUND_BPLUSTREE_HPP
@@ -1,117 +1,246 @@
 #ifndef PLAYGROUND_BINARYSEARCHTREE_HPP
 #define PLAYGROUND_BINARYSEARCHTREE_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
-template<typename T>
+// The balancing policies of BinarySearchTree. A policy keeps its own NodeState in every
+// node and gets to rebalance(tree, link) each subtree on the path of an addition or a
+// removal, bottom up, using the rotations of the tree.
+
+// No rebalancing at all: the shape depends on the order of additions, so a sorted
+// sequence of them degrades the tree into a list.
+struct NoBalancing {
+    struct NodeState {};
+
+    template<typename Tree, typename Index>
+    static void rebalance(Tree&, Index&) {}
+};
+
+// AVL trees: the heights of the two subtrees of every node differ by at most one, so
+// the height stays below 1.45 log2(n) and every operation is O(log n).
+struct AvlBalancing {
+    struct NodeState {
+        int8_t height = 1; // of the subtree, the node itself included
+    };
+
+    template<typename Tree, typename Index>
+    static void rebalance(Tree& tree, Index& link) {
+        if (link == Tree::nil)
+            return;
+
+        int balance = height(tree, tree.left(link)) - height(tree, tree.right(link));
+        if (balance > 1) {
+            Index& left = tree.left(link);
+            if (height(tree, tree.left(left)) < height(tree, tree.right(left))) {
+                tree.rotate_left(left);
+                update(tree, tree.left(left));
+            }
+            tree.rotate_right(link);
+            update(tree, tree.right(link));
+        } else if (balance < -1) {
+            Index& right = tree.right(link);
+            if (height(tree, tree.right(right)) < height(tree, tree.left(right))) {
+                tree.rotate_right(right);
+                update(tree, tree.right(right));
+            }
+            tree.rotate_left(link);
+            update(tree, tree.left(link));
+        }
+        update(tree, link);
+    }
+
+private:
+    template<typename Tree, typename Index>
+    static int height(Tree& tree, Index node) { return node == Tree::nil ? 0 : tree.state(node).height; }
+
+    template<typename Tree, typename Index>
+    static void update(Tree& tree, Index node) {
+        if (node != Tree::nil)
+            tree.state(node).height = 1 + std::max(height(tree, tree.left(node)), height(tree, tree.right(node)));
+    }
+};
+
+// The nodes live in one contiguous arena and refer to their children by 32-bit indices
+// instead of pointers, so they're half the size on 64-bit machines and are allocated
+// with an amortized push_back rather than a call to new each. Removed nodes are chained
+// into a free list (through their left index) and reused by the next additions.
+//
+// Nothing is recursive: copying copies the arena as is, destroying frees it in one go,
+// and printing walks the tree with an explicit stack, so a degenerate tree is no problem.
+//
+// BALANCING is one of the policies above; the links followed by an addition or a removal
+// are recorded, so that the policy can walk back up along them.
+template<typename T, typename BALANCING = NoBalancing>
 class BinarySearchTree {
 private:
-    struct Node {
+    friend BALANCING;
+
+    typedef uint32_t Index;
+    static constexpr Index nil = UINT32_MAX;
+
+    struct Node : BALANCING::NodeState {
         T data;
-        Node* left;
-        Node* right;
+        Index left;
+        Index right;
 
-        explicit Node(T data, Node* left = nullptr, Node* right = nullptr) : data(data), left(left), right(right) {}
+        explicit Node(const T& data) : data(data), left(nil), right(nil) {}
+    };
 
-        Node(const Node& node) : data(node.data), left(node.left == nullptr ? nullptr : new Node(*node.left)),
-                                 right(node.right == nullptr ? nullptr : new Node(*node.right)) {}
+    std::vector<Node> nodes;
+    Index free_list; // the first freed node, whose left is the next one, and so on
+    Index root;
+    std::vector<Index*> path; // the links followed by the last addition or removal, from the root down
 
-        Node& operator=(Node node) {
-            data = node.data;
-            std::swap(left, node.left);
-            std::swap(right, node.right);
-            return *this;
-        }
+    Index& left(Index node) { return nodes[node].left; }
 
-        ~Node() {
-            delete left;
-            delete right;
-        }
+    Index& right(Index node) { return nodes[node].right; }
 
-        void print(std::ostream& os) const {
-            if (left != nullptr)
-                left->print(os);
-            os << " " << data;
-            if (right != nullptr)
-                right->print(os);
-        }
-    };
+    typename BALANCING::NodeState& state(Index node) { return nodes[node]; }
 
-    Node** find(Node** where, const T& data) {
-        while (*where != nullptr)
-            if ((*where)->data == data)
+    // the right child of the node at link takes its place
+    void rotate_left(Index& link) {
+        Index node = link;
+        Index pivot = nodes[node].right;
+        nodes[node].right = nodes[pivot].left;
+        nodes[pivot].left = node;
+        link = pivot;
+    }
+
+    // the left child of the node at link takes its place
+    void rotate_right(Index& link) {
+        Index node = link;
+        Index pivot = nodes[node].left;
+        nodes[node].left = nodes[pivot].right;
+        nodes[pivot].right = node;
+        link = pivot;
+    }
+
+    // the link (in the parent, or root) that points to the node of data, or would, if there was one;
+    // it's only valid until the arena grows
+    Index* find(Index* where, const T& data) {
+        path.push_back(where);
+        while (*where != nil) {
+            if (nodes[*where].data == data)
                 return where;
-            else if ((*where)->data > data)
-                where = &(*where)->left;
-            else if ((*where)->data < data)
-                where = &(*where)->right;
+            else if (nodes[*where].data > data)
+                where = &nodes[*where].left;
+            else if (nodes[*where].data < data)
+                where = &nodes[*where].right;
+            path.push_back(where);
+        }
+        return where;
+    }
+
+    Index* find_min(Index* where) {
+        while (*where != nil && nodes[*where].left != nil) {
+            where = &nodes[*where].left;
+            path.push_back(where);
+        }
         return where;
     }
 
-    Node** find_min(Node** where) {
-        if (*where == nullptr || (*where)->left == nullptr)
-            return where;
-        return find_min(&(*where)->left);
+    void rebalance_path() {
+        for (size_t idx = path.size(); idx-- > 0;)
+            BALANCING::rebalance(*this, *path[idx]);
+        path.clear();
+    }
+
+    Index allocate(const T& data) {
+        if (free_list != nil) {
+            Index node = free_list;
+            free_list = nodes[node].left;
+            nodes[node] = Node(data);
+            return node;
+        }
+        if (nodes.size() == nil)
+            throw std::length_error("Too many nodes in the binary search tree");
+        nodes.push_back(Node(data));
+        return nodes.size() - 1;
     }
 
-    void remove(Node** where) {
-        if (*where == nullptr)
+    void release(Index node) {
+        nodes[node].left = free_list;
+        free_list = node;
+    }
+
+    void remove(Index* where) {
+        if (*where == nil)
             return;
 
-        if ((*where)->left != nullptr && (*where)->right != nullptr) {
-            Node** min_on_the_right = find_min(&(*where)->right);
-            std::swap((*where)->data, (*min_on_the_right)->data);
-            remove(min_on_the_right);
-        } else {
-            Node* what = *where;
-
-            if (what->left != nullptr && what->right == nullptr)
-                *where = what->left;
-            else if (what->left == nullptr && what->right != nullptr)
-                *where = what->right;
-            else
-                *where = nullptr;
-
-            delete what;
+        if (nodes[*where].left != nil && nodes[*where].right != nil) {
+            path.push_back(&nodes[*where].right);
+            Index* min_on_the_right = find_min(&nodes[*where].right);
+            std::swap(nodes[*where].data, nodes[*min_on_the_right].data);
+            where = min_on_the_right; // which has no left child, so it's one of the cases below
         }
+
+        Index what = *where;
+        if (nodes[what].left != nil && nodes[what].right == nil)
+            *where = nodes[what].left;
+        else if (nodes[what].left == nil && nodes[what].right != nil)
+            *where = nodes[what].right;
+        else
+            *where = nil;
+
+        release(what);
     }
 
-    Node* root;
 public:
-    BinarySearchTree() : root(nullptr) {}
+    BinarySearchTree() : free_list(nil), root(nil) {}
 
-    BinarySearchTree(std::initializer_list<T> values) : root(nullptr) {
+    BinarySearchTree(std::initializer_list<T> values) : free_list(nil), root(nil) {
+        nodes.reserve(values.size());
         for (T value: values)
             add(value);
     }
 
-    BinarySearchTree(const BinarySearchTree& bst) : root(new Node(*bst.root)) {}
-
-    BinarySearchTree& operator=(BinarySearchTree bst) {
-        std::swap(root, bst.root);
-        return *this;
-    }
-
     void add(const T& data) {
-        Node** where = find(&root, data);
-        if (*where == nullptr)
-            *where = new Node(data);
+        // growing the arena would invalidate the link found, so it's done beforehand
+        if (free_list == nil && nodes.size() == nodes.capacity())
+            nodes.reserve(std::max<size_t>(16, 2 * nodes.capacity()));
+
+        Index* where = find(&root, data);
+        if (*where == nil)
+            *where = allocate(data);
+        rebalance_path();
     }
 
     void remove(const T& data) {
-        Node** where = find(&root, data);
+        Index* where = find(&root, data);
         remove(where);
+        rebalance_path();
     }
 
-    void print(std::ostream& os) const {
-        root->print(os);
+    // calls f on the values in increasing order
+    template<typename F>
+    void for_each(F&& f) const {
+        std::vector<Index> stack;
+        Index node = root;
+        while (node != nil || !stack.empty()) {
+            for (; node != nil; node = nodes[node].left)
+                stack.push_back(node);
+            node = stack.back();
+            stack.pop_back();
+            f(nodes[node].data);
+            node = nodes[node].right;
+        }
     }
 
-    ~BinarySearchTree() { delete root; }
+    void print(std::ostream& os) const {
+        for_each([&](const T& data) { os << " " << data; });
+    }
 };
 
-template<typename T>
-std::ostream& operator<<(std::ostream& os, const BinarySearchTree<T>& bst) {
+template<typename T> using AvlTree = BinarySearchTree<T, AvlBalancing>;
+
+template<typename T, typename BALANCING>
+std::ostream& operator<<(std::ostream& os, const BinarySearchTree<T, BALANCING>& bst) {
     os << "Binary Search Tree:";
     bst.print(os);
     return os;
@@ -0,0 +1,259 @@
+#ifndef PLAYGROUND_CONCURRENTSKIPLIST_HPP
+#define PLAYGROUND_CONCURRENTSKIPLIST_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include "EpochReclamation.hpp"
+
+// An ordered set shared by threads: a lock-free skip list (Fraser's, as presented by
+// Herlihy and Shavit). Every node is in the list of level 0 and, with a probability of
+// 1/2 each, in the lists of the levels above, so a search skips ahead on the upper levels
+// and goes down whenever it would overshoot. add, remove and contains never block: a
+// thread held up in the middle of one doesn't keep the others waiting.
+//
+// A node is removed by marking its links (the lowest bit of each pointer) from the top
+// down; the mark of level 0 is what takes it out of the set. Marked nodes are unlinked
+// by whichever search comes across them, and retired to an EpochReclamation once both
+// its adder and its remover are done with it (the adder may still be linking it into the
+// upper levels while it's removed). contains only reads, skipping the marked nodes.
+//
+// As with EpochReclamation, every call takes the index of the calling thread, in
+// [0, thread_count), which mustn't be used by two threads at the same time. Only
+// operator< is used on the keys, which have to be default constructible.
+template<typename T>
+class ConcurrentSkipList {
+private:
+    static constexpr int max_height = 32;
+
+    typedef std::atomic<uintptr_t> Link; // a pointer to the next node, its lowest bit marking the node removed
+
+    // followed by its height links in the same allocation
+    struct alignas(std::max(alignof(T), alignof(Link))) Node {
+        T key;
+        int height;
+        std::atomic<int> owners; // the adder and the remover, the last one done with the node retires it
+
+        Node(const T& key, int height) : key(key), height(height), owners(2) {}
+
+        Link* links() { return reinterpret_cast<Link*>(this + 1); }
+    };
+
+    struct alignas(64) ThreadState {
+        uint64_t random;
+    };
+
+    EpochReclamation reclamation;
+    std::vector<ThreadState> threads;
+    Node* head; // of the full height, its key is never looked at
+
+    static Node* pointer(uintptr_t link) { return reinterpret_cast<Node*>(link & ~uintptr_t(1)); }
+
+    static bool marked(uintptr_t link) { return (link & 1) != 0; }
+
+    static uintptr_t unmarked(Node* node) { return reinterpret_cast<uintptr_t>(node); }
+
+    static Node* create(const T& key, int height) {
+        void* memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+        Node* node;
+        try {
+            node = new(memory) Node(key, height);
+        } catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+        for (int level = 0; level < height; level++)
+            new(&node->links()[level]) Link(0);
+        return node;
+    }
+
+    static void destroy(void* memory) {
+        static_cast<Node*>(memory)->~Node();
+        ::operator delete(memory);
+    }
+
+    // xorshift, then the number of trailing ones: 1 with a probability of 1/2, 2 with 1/4, ...
+    int random_height(size_t thread) {
+        uint64_t& random = threads[thread].random;
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        int height = 1;
+        for (uint64_t bits = random; (bits & 1) != 0 && height < max_height; bits >>= 1)
+            height++;
+        return height;
+    }
+
+    // fills in the last nodes less than key (preds) and the first ones not less (succs) on
+    // every level, unlinking the marked nodes on the way; false if it has to be started over
+    bool try_find(const T& key, Node** preds, Node** succs) {
+        Node* pred = head;
+        for (int level = max_height - 1; level >= 0; level--) {
+            Node* curr = pointer(pred->links()[level].load(std::memory_order_acquire));
+            while (curr != nullptr) {
+                uintptr_t succ = curr->links()[level].load(std::memory_order_acquire);
+                if (marked(succ)) {
+                    // fails if pred has been marked or something has been linked after it
+                    uintptr_t expected = unmarked(curr);
+                    if (!pred->links()[level].compare_exchange_strong(expected, succ & ~uintptr_t(1)))
+                        return false;
+                    curr = pointer(succ);
+                } else if (curr->key < key) {
+                    pred = curr;
+                    curr = pointer(succ);
+                } else {
+                    break;
+                }
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return true;
+    }
+
+    // true if key is in the set (as succs[0])
+    bool find(const T& key, Node** preds, Node** succs) {
+        while (!try_find(key, preds, succs));
+        return succs[0] != nullptr && !(key < succs[0]->key);
+    }
+
+    // links the node (already in the set) into the list of level; false if it's been removed meanwhile
+    bool link(Node* node, int level, Node** preds, Node** succs) {
+        while (true) {
+            uintptr_t next = node->links()[level].load();
+            if (marked(next))
+                return false;
+            if (pointer(next) != succs[level] &&
+                !node->links()[level].compare_exchange_strong(next, unmarked(succs[level])))
+                continue;
+
+            uintptr_t expected = unmarked(succs[level]);
+            if (preds[level]->links()[level].compare_exchange_strong(expected, unmarked(node)))
+                return true;
+            if (!find(node->key, preds, succs) || succs[0] != node)
+                return false;
+        }
+    }
+
+    void release(Node* node, size_t thread) {
+        if (node->owners.fetch_sub(1) == 1)
+            reclamation.retire(thread, node, &destroy);
+    }
+
+public:
+    explicit ConcurrentSkipList(size_t thread_count) : reclamation(thread_count), threads(thread_count),
+                                                       head(create(T(), max_height)) {
+        for (size_t thread = 0; thread < thread_count; thread++)
+            threads[thread].random = 0x9E3779B97F4A7C15ULL * (thread + 1);
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    // no thread may use the set anymore
+    ~ConcurrentSkipList() {
+        Node* node = head;
+        while (node != nullptr) {
+            Node* next = pointer(node->links()[0].load());
+            destroy(node);
+            node = next;
+        }
+    }
+
+    bool add(const T& key, size_t thread) {
+        EpochReclamation::Guard guard(reclamation, thread);
+        Node* preds[max_height];
+        Node* succs[max_height];
+        int height = random_height(thread);
+        Node* node = nullptr;
+        while (true) {
+            if (find(key, preds, succs)) {
+                if (node != nullptr)
+                    destroy(node); // never published
+                return false;
+            }
+            if (node == nullptr)
+                node = create(key, height);
+            for (int level = 0; level < height; level++)
+                node->links()[level].store(unmarked(succs[level]), std::memory_order_relaxed);
+
+            uintptr_t expected = unmarked(succs[0]);
+            if (preds[0]->links()[0].compare_exchange_strong(expected, unmarked(node)))
+                break;
+        }
+
+        for (int level = 1; level < height; level++)
+            if (!link(node, level, preds, succs))
+                break;
+        // if it's been removed meanwhile, its remover may have missed the levels linked since
+        if (marked(node->links()[0].load()))
+            find(key, preds, succs);
+        release(node, thread);
+        return true;
+    }
+
+    bool remove(const T& key, size_t thread) {
+        EpochReclamation::Guard guard(reclamation, thread);
+        Node* preds[max_height];
+        Node* succs[max_height];
+        if (!find(key, preds, succs))
+            return false;
+
+        Node* node = succs[0];
+        for (int level = node->height - 1; level > 0; level--) {
+            uintptr_t next = node->links()[level].load();
+            while (!marked(next) && !node->links()[level].compare_exchange_weak(next, next | 1));
+        }
+        uintptr_t next = node->links()[0].load();
+        while (true) {
+            if (marked(next))
+                return false; // someone else has removed it first
+            if (node->links()[0].compare_exchange_weak(next, next | 1))
+                break;
+        }
+
+        find(key, preds, succs); // unlinks it from every level
+        release(node, thread);
+        return true;
+    }
+
+    bool contains(const T& key, size_t thread) {
+        EpochReclamation::Guard guard(reclamation, thread);
+        Node* pred = head;
+        Node* curr = nullptr;
+        for (int level = max_height - 1; level >= 0; level--) {
+            curr = pointer(pred->links()[level].load(std::memory_order_acquire));
+            while (curr != nullptr) {
+                uintptr_t succ = curr->links()[level].load(std::memory_order_acquire);
+                if (marked(succ)) {
+                    curr = pointer(succ);
+                } else if (curr->key < key) {
+                    pred = curr;
+                    curr = pointer(succ);
+                } else {
+                    break;
+                }
+            }
+        }
+        return curr != nullptr && !(key < curr->key);
+    }
+
+    // calls f on the keys in increasing order; keys added or removed meanwhile may or may not be seen
+    template<typename F>
+    void for_each(F&& f, size_t thread) {
+        EpochReclamation::Guard guard(reclamation, thread);
+        Node* node = pointer(head->links()[0].load(std::memory_order_acquire));
+        while (node != nullptr) {
+            uintptr_t next = node->links()[0].load(std::memory_order_acquire);
+            if (!marked(next))
+                f(node->key);
+            node = pointer(next);
+        }
+    }
+};
+
+#endif //PLAYGROUND_CONCURRENTSKIPLIST_HPP
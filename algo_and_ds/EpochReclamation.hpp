@@ -0,0 +1,107 @@
+#ifndef PLAYGROUND_EPOCHRECLAMATION_HPP
+#define PLAYGROUND_EPOCHRECLAMATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Epoch-based reclamation of the memory of lock-free data structures: a node unlinked by
+// one thread may still be read by others that found it before, so instead of freeing it
+// right away it is retired, and freed once no thread can hold a reference to it anymore.
+//
+// Every operation on the data structure runs pinned (holding a Guard), announcing the
+// global epoch it saw. The epoch is advanced once every pinned thread has seen the current
+// one. A node retired at epoch e was unreachable before e was read, so only threads pinned
+// at e or earlier may have seen it; once the epoch is at e + 2, all of those are gone.
+//
+// The threads are told apart by indices in [0, thread_count), as the workers of ThreadPool
+// are: an index mustn't be used by two threads at the same time. A thread that stays pinned
+// holds back the reclamation of everything retired after it pinned, so the guards should
+// be short-lived.
+class EpochReclamation {
+private:
+    static constexpr uint64_t idle = UINT64_MAX;
+    static constexpr size_t collect_interval = 64; // retirements between two attempts at freeing
+
+    struct Retired {
+        uint64_t epoch;
+        void* pointer;
+        void (*deleter)(void*);
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{idle}; // the one seen when pinned, or idle
+        std::vector<Retired> retired;      // in the order of retirement, thus of epochs
+        size_t retired_since_collect = 0;
+    };
+
+    std::atomic<uint64_t> global_epoch;
+    std::vector<Slot> slots;
+
+    void try_advance() {
+        uint64_t epoch = global_epoch.load();
+        for (Slot const& slot: slots) {
+            uint64_t seen = slot.epoch.load();
+            if (seen != idle && seen != epoch)
+                return;
+        }
+        global_epoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    void collect(Slot& slot) {
+        try_advance();
+        uint64_t epoch = global_epoch.load();
+        size_t freed = 0;
+        while (freed < slot.retired.size() && slot.retired[freed].epoch + 2 <= epoch) {
+            slot.retired[freed].deleter(slot.retired[freed].pointer);
+            freed++;
+        }
+        slot.retired.erase(slot.retired.begin(), slot.retired.begin() + freed);
+    }
+
+public:
+    class Guard {
+    private:
+        Slot& slot;
+
+    public:
+        Guard(EpochReclamation& reclamation, size_t thread) : slot(reclamation.slots[thread]) {
+            slot.epoch.store(reclamation.global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // before reading anything of the data structure
+        }
+
+        Guard(const Guard&) = delete;
+
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() { slot.epoch.store(idle, std::memory_order_release); }
+    };
+
+    explicit EpochReclamation(size_t thread_count) : global_epoch(0), slots(thread_count) {}
+
+    EpochReclamation(const EpochReclamation&) = delete;
+
+    EpochReclamation& operator=(const EpochReclamation&) = delete;
+
+    // frees everything still retired, so no thread may be pinned anymore
+    ~EpochReclamation() {
+        for (Slot& slot: slots)
+            for (Retired const& retired: slot.retired)
+                retired.deleter(retired.pointer);
+    }
+
+    size_t threadCount() const { return slots.size(); }
+
+    // pointer has to be unreachable for threads pinning from now on; deleter frees it later
+    void retire(size_t thread, void* pointer, void (*deleter)(void*)) {
+        Slot& slot = slots[thread];
+        slot.retired.push_back(Retired{global_epoch.load(), pointer, deleter});
+        if (++slot.retired_since_collect == collect_interval) {
+            slot.retired_since_collect = 0;
+            collect(slot);
+        }
+    }
+};
+
+#endif //PLAYGROUND_EPOCHRECLAMATION_HPP
@@ -1,70 +1,172 @@
 #ifndef PLAYGROUND_HEAP_HPP
 #define PLAYGROUND_HEAP_HPP
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <utility>
 #include <vector>
 
-template<typename T, typename CMP>
+// An allocator handing out memory aligned to cache line boundaries.
+template<typename T, size_t ALIGNMENT = 64>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = CacheAlignedAllocator<U, ALIGNMENT>;
+    };
+
+    CacheAlignedAllocator() = default;
+
+    template<typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U, ALIGNMENT>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+    }
+
+    void deallocate(T* ptr, size_t) {
+        ::operator delete(ptr, std::align_val_t(ALIGNMENT));
+    }
+
+    template<typename U>
+    bool operator==(const CacheAlignedAllocator<U, ALIGNMENT>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const CacheAlignedAllocator<U, ALIGNMENT>&) const { return false; }
+};
+
+// A d-ary heap, where the children of node n are ARITY * n + 1, ..., ARITY * n + ARITY.
+//
+// A wider heap is shallower, so fewer levels (thus fewer cache lines) are touched
+// by a removal, at the cost of more comparisons per level. To make these comparisons
+// cheap, for an ARITY above 2 every group of siblings is kept inside a single cache
+// line (given that ARITY * sizeof(T) divides the line size): the buffer is
+// cache-aligned and the root is preceded by ARITY - 1 unused slots, which puts the
+// first child of every node at a multiple of ARITY. For these wider heaps T must be
+// default constructible. The binary heap isn't padded (so that it takes any T): its
+// pairs of siblings start at odd indices, and may straddle two cache lines.
+template<typename T, typename CMP, size_t ARITY = 2>
 class Heap {
 private:
+    static_assert(ARITY >= 2, "A heap has to have an arity of at least 2.");
+
     static const CMP cmp;
-    std::vector<T> data;
+    static constexpr size_t offset = ARITY > 2 ? ARITY - 1 : 0;
+    std::vector<T, CacheAlignedAllocator<T>> data;
+
+    T& at(size_t node) { return data[offset + node]; }
 
     size_t up_heap(size_t node) {
         size_t parent;
-        while (node > 0 && cmp(data[node], data[parent = (node - 1) / 2])) {
-            std::swap(data[node], data[parent]);
+        while (node > 0 && cmp(at(node), at(parent = (node - 1) / ARITY))) {
+            std::swap(at(node), at(parent));
             node = parent;
         }
         return node;
     }
 
     size_t down_heap(size_t node) {
-        size_t left, right;
-        while ((left = 2 * node + 1) < data.size()) {
-            right = left + 1;
-
-            size_t extreme_child = (right == data.size() || cmp(data[left], data[right])) ? left : right;
-            if (cmp(data[node], data[extreme_child]))
+        size_t first, count = size();
+        while ((first = ARITY * node + 1) < count) {
+            size_t last = first + ARITY < count ? first + ARITY : count;
+
+            size_t extreme_child = first;
+            for (size_t child = first + 1; child < last; child++)
+                if (cmp(at(child), at(extreme_child)))
+                    extreme_child = child;
+            if (cmp(at(node), at(extreme_child)))
                 break;
 
-            std::swap(data[node], data[extreme_child]);
+            std::swap(at(node), at(extreme_child));
             node = extreme_child;
         }
         return node;
     }
 
+    // Floyd's bottom-up construction: every subtree is made a heap by sifting its root
+    // down, starting from the last inner node, which takes O(n) in total.
+    void heapify() {
+        if (size() < 2)
+            return;
+        for (size_t node = (size() - 2) / ARITY + 1; node-- > 0;)
+            down_heap(node);
+    }
+
 public:
-    Heap() = default;
+    Heap() : data(offset) {}
 
-    Heap(std::initializer_list<T> values) : data(values) {
-        for (size_t node = data.size() - 1; node > 0; node--)
-            if (up_heap(node) == node)  // if can't go upwards
-                down_heap(node);        // go downwards
+    Heap(std::initializer_list<T> values) : Heap(values.begin(), values.end()) {}
+
+    template<typename ITERATOR>
+    Heap(ITERATOR first, ITERATOR last) : data(offset) {
+        data.insert(data.end(), first, last);
+        heapify();
+    }
+
+    explicit Heap(std::vector<T>&& values) : data(offset) {
+        data.reserve(offset + values.size());
+        data.insert(data.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        values.clear();
+        heapify();
     }
 
     void insert(const T& value) {
         data.push_back(value);
-        up_heap(data.size() - 1);
+        up_heap(size() - 1);
     }
 
-    T& extreme() { return data[0]; }
+    void insert(T&& value) {
+        data.push_back(std::move(value));
+        up_heap(size() - 1);
+    }
 
-    const T& extreme() const { return data[0]; }
+    // Sifting up every new element costs O(k log n), while rebuilding the whole heap costs
+    // O(n + k), so the latter is chosen whenever the batch is large compared to the heap.
+    template<typename ITERATOR>
+    void insert_bulk(ITERATOR first, ITERATOR last) {
+        size_t old_size = size();
+        data.insert(data.end(), first, last);
+
+        size_t batch = size() - old_size, depth = 1;
+        for (size_t level_size = size(); level_size >= ARITY; level_size /= ARITY)
+            depth++;
+
+        if (batch * depth > size()) {
+            heapify();
+        } else {
+            for (size_t node = old_size; node < size(); node++)
+                up_heap(node);
+        }
+    }
+
+    void insert_bulk(std::vector<T>&& values) {
+        insert_bulk(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        values.clear();
+    }
+
+    T& extreme() { return at(0); }
+
+    const T& extreme() const { return data[offset]; }
 
     void extreme_remove() {
-        data[0] = data[data.size() - 1];
+        at(0) = std::move(data[data.size() - 1]);
         data.pop_back();
         down_heap(0);
     }
 
-    bool empty() const { return data.empty(); }
+    size_t size() const { return data.size() - offset; }
+
+    bool empty() const { return data.size() == offset; }
 };
 
-template<typename T> using MinHeap = Heap<T, std::less<T>>;
+template<typename T, size_t ARITY = 2> using MinHeap = Heap<T, std::less<T>, ARITY>;
 
-template<typename T> using MaxHeap = Heap<T, std::greater<T>>;
+template<typename T, size_t ARITY = 2> using MaxHeap = Heap<T, std::greater<T>, ARITY>;
 
-template<typename T, typename CMP> const CMP Heap<T, CMP>::cmp;
+template<typename T, typename CMP, size_t ARITY> const CMP Heap<T, CMP, ARITY>::cmp;
 
 #endif //PLAYGROUND_HEAP_HPP
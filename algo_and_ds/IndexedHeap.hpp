@@ -0,0 +1,140 @@
+#ifndef PLAYGROUND_INDEXEDHEAP_HPP
+#define PLAYGROUND_INDEXEDHEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// A heap of keys from [0, key_count), each having a priority of type T.
+// Since the heap slot of every key is tracked, a key can be looked up, moved or
+// removed in O(log n), so a key is never present more than once.
+//
+// decrease_key/increase_key are meant in the sense of the heap's ordering:
+// decreasing moves a key towards the extreme (up), increasing moves it away (down).
+template<typename T, typename CMP>
+class IndexedHeap {
+private:
+    static const CMP cmp;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct Entry {
+        T priority;
+        size_t key;
+    };
+
+    std::vector<Entry> data;
+    std::vector<size_t> positions; // slot of each key in data, or npos if absent
+
+    void place(size_t node, Entry entry) {
+        positions[entry.key] = node;
+        data[node] = std::move(entry);
+    }
+
+    size_t up_heap(size_t node) {
+        Entry entry = std::move(data[node]);
+        size_t parent;
+        while (node > 0 && cmp(entry.priority, data[parent = (node - 1) / 2].priority)) {
+            place(node, std::move(data[parent]));
+            node = parent;
+        }
+        place(node, std::move(entry));
+        return node;
+    }
+
+    size_t down_heap(size_t node) {
+        Entry entry = std::move(data[node]);
+        size_t left, right;
+        while ((left = 2 * node + 1) < data.size()) {
+            right = left + 1;
+
+            size_t extreme_child = (right == data.size() || cmp(data[left].priority, data[right].priority)) ? left : right;
+            if (!cmp(data[extreme_child].priority, entry.priority))
+                break;
+
+            place(node, std::move(data[extreme_child]));
+            node = extreme_child;
+        }
+        place(node, std::move(entry));
+        return node;
+    }
+
+    // removes the entry in the given slot by moving the last one there
+    void remove_at(size_t node) {
+        positions[data[node].key] = npos;
+        if (node != data.size() - 1) {
+            place(node, std::move(data.back()));
+            data.pop_back();
+            if (up_heap(node) == node)
+                down_heap(node);
+        } else {
+            data.pop_back();
+        }
+    }
+
+public:
+    explicit IndexedHeap(size_t key_count = 0) : positions(key_count, npos) {}
+
+    size_t size() const { return data.size(); }
+
+    bool empty() const { return data.empty(); }
+
+    bool contains(size_t key) const { return positions[key] != npos; }
+
+    const T& priority(size_t key) const { return data[positions[key]].priority; }
+
+    void insert(size_t key, const T& priority) {
+        data.push_back(Entry{priority, key});
+        positions[key] = data.size() - 1;
+        up_heap(data.size() - 1);
+    }
+
+    void decrease_key(size_t key, const T& priority) {
+        size_t node = positions[key];
+        data[node].priority = priority;
+        up_heap(node);
+    }
+
+    void increase_key(size_t key, const T& priority) {
+        size_t node = positions[key];
+        data[node].priority = priority;
+        down_heap(node);
+    }
+
+    // inserts the key if it's absent, otherwise moves it in whichever direction its new priority requires
+    void update(size_t key, const T& priority) {
+        if (!contains(key)) {
+            insert(key, priority);
+        } else if (cmp(priority, data[positions[key]].priority)) {
+            decrease_key(key, priority);
+        } else {
+            increase_key(key, priority);
+        }
+    }
+
+    void erase(size_t key) {
+        if (contains(key))
+            remove_at(positions[key]);
+    }
+
+    // removes every key in O(size), leaving the heap ready for reuse without reallocating anything
+    void clear() {
+        for (Entry const& entry: data)
+            positions[entry.key] = npos;
+        data.clear();
+    }
+
+    size_t extreme_key() const { return data[0].key; }
+
+    const T& extreme() const { return data[0].priority; }
+
+    void extreme_remove() { remove_at(0); }
+};
+
+template<typename T> using MinIndexedHeap = IndexedHeap<T, std::less<T>>;
+
+template<typename T> using MaxIndexedHeap = IndexedHeap<T, std::greater<T>>;
+
+template<typename T, typename CMP> const CMP IndexedHeap<T, CMP>::cmp;
+
+#endif //PLAYGROUND_INDEXEDHEAP_HPP
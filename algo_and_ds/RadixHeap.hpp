@@ -0,0 +1,87 @@
+#ifndef PLAYGROUND_RADIXHEAP_HPP
+#define PLAYGROUND_RADIXHEAP_HPP
+
+#include <climits>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// A monotone min-priority queue for unsigned integer keys: a key may not be smaller
+// than the last one removed (which holds for e.g. the distances of Dijkstra's algorithm).
+//
+// Bucket i holds the keys whose highest bit differing from the last removed key is
+// bit i - 1 (bucket 0 holds the keys equal to it). Every key can only move to lower
+// buckets, so an operation takes amortized O(log C) for keys up to C, and all that
+// is done is appending to and sweeping through plain arrays, no sifting.
+template<typename T>
+class RadixHeap {
+private:
+    static constexpr size_t bucket_count = sizeof(unsigned) * CHAR_BIT + 1;
+
+    std::vector<std::pair<unsigned, T>> buckets[bucket_count];
+    unsigned last;
+    size_t count;
+
+    static size_t bit_width(unsigned x) {
+#if defined(__GNUC__)
+        return x == 0 ? 0 : sizeof(unsigned) * CHAR_BIT - __builtin_clz(x);
+#else
+        size_t width = 0;
+        for (; x != 0; x >>= 1)
+            width++;
+        return width;
+#endif
+    }
+
+    size_t bucket_of(unsigned key) const { return bit_width(key ^ last); }
+
+    // makes sure that the smallest key is in bucket 0 by redistributing the first non-empty bucket
+    void pull() {
+        if (!buckets[0].empty())
+            return;
+
+        size_t idx = 1;
+        while (buckets[idx].empty())
+            idx++;
+
+        unsigned min_key = buckets[idx][0].first;
+        for (auto const& entry: buckets[idx])
+            if (entry.first < min_key)
+                min_key = entry.first;
+
+        last = min_key;
+        for (auto& entry: buckets[idx])
+            buckets[bucket_of(entry.first)].push_back(std::move(entry));
+        buckets[idx].clear();
+    }
+
+public:
+    RadixHeap() : last(0), count(0) {}
+
+    void insert(unsigned key, const T& value) {
+        buckets[bucket_of(key)].emplace_back(key, value);
+        count++;
+    }
+
+    unsigned extreme_key() {
+        pull();
+        return buckets[0].back().first;
+    }
+
+    T& extreme() {
+        pull();
+        return buckets[0].back().second;
+    }
+
+    void extreme_remove() {
+        pull();
+        buckets[0].pop_back();
+        count--;
+    }
+
+    size_t size() const { return count; }
+
+    bool empty() const { return count == 0; }
+};
+
+#endif //PLAYGROUND_RADIXHEAP_HPP
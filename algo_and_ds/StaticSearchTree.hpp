@@ -0,0 +1,270 @@
+#ifndef PLAYGROUND_STATICSEARCHTREE_HPP
+#define PLAYGROUND_STATICSEARCHTREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "BinarySearchTree.hpp"
+#include "Heap.hpp"
+
+// Build-once search trees for read-mostly lookups: the keys of a BinarySearchTree (or of
+// a sorted range) are frozen into an implicit tree in a single array, so a lookup computes
+// where the next node is instead of loading a pointer to it, and touches far fewer cache
+// lines than a pointer-based tree or a binary search over the sorted keys does.
+//
+// lower_bound returns the first key not less than the one looked up, or nullptr if every
+// key is less. The batched lookups descend for a group of keys at once, level by level,
+// so that the cache misses of the group overlap instead of following each other.
+//
+// Only operator< is used on the keys, which have to be default constructible.
+
+namespace static_search_tree {
+    inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#endif
+    }
+
+    template<typename T, typename BALANCING>
+    std::vector<T> sorted_values(const BinarySearchTree<T, BALANCING>& bst) {
+        std::vector<T> sorted;
+        bst.for_each([&](const T& value) { sorted.push_back(value); });
+        return sorted;
+    }
+
+    template<typename T>
+    void check_sorted(const std::vector<T>& sorted) {
+        if (!std::is_sorted(sorted.begin(), sorted.end()))
+            throw std::runtime_error("The keys of a static search tree have to be sorted");
+    }
+
+    // how many keys (of a group of siblings, thus a power of 2) fit into a cache line
+    template<typename T>
+    constexpr size_t keys_per_line() {
+        size_t count = 1;
+        while (2 * count * sizeof(T) <= 64)
+            count *= 2;
+        return count;
+    }
+}
+
+// The Eytzinger (BFS) layout: keys[1] is the root and the children of keys[k] are keys[2k]
+// and keys[2k + 1], as in a binary heap. A lookup goes down one level per step without a
+// branch (the comparison picks the child), and prefetches the cache line holding the 16
+// (for 4-byte keys) descendants of the node 4 levels below, so that the line is already
+// there by the time the descent gets to it.
+//
+// Once the descent falls off the tree, the path taken is encoded in the bits of k: the
+// answer is the last node where it went left, found by stripping the trailing right turns.
+template<typename T>
+class EytzingerSearchTree {
+private:
+    static constexpr size_t batch_size = 16;
+    static constexpr size_t prefetch_distance = static_search_tree::keys_per_line<T>();
+
+    std::vector<T, CacheAlignedAllocator<T>> keys; // keys[0] is unused, so that siblings share cache lines
+    size_t n;
+    size_t full_levels; // the levels having every node, so the descent needn't check for the end
+
+    // fills the subtree of k from sorted[next...] in order, returns the next key left
+    size_t fill(const std::vector<T>& sorted, size_t next, size_t k) {
+        if (k <= n) {
+            next = fill(sorted, next, 2 * k);
+            keys[k] = sorted[next++];
+            next = fill(sorted, next, 2 * k + 1);
+        }
+        return next;
+    }
+
+    void build(const std::vector<T>& sorted) {
+        static_search_tree::check_sorted(sorted);
+        n = sorted.size();
+        keys.resize(n + 1);
+        fill(sorted, 0, 1);
+        for (full_levels = 0; (size_t(2) << full_levels) - 1 <= n; full_levels++);
+    }
+
+    size_t step(size_t k, const T& key) const {
+        static_search_tree::prefetch(keys.data() + k * prefetch_distance);
+        return 2 * k + (keys[k] < key);
+    }
+
+    // the descent after the full levels, at most one more step on the last, partial one
+    const T* finish(size_t k, const T& key) const {
+        if (k <= n)
+            k = 2 * k + (keys[k] < key);
+        k >>= count_trailing_ones(k) + 1;
+        return k == 0 ? nullptr : &keys[k];
+    }
+
+    static size_t count_trailing_ones(size_t k) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+        size_t ones = 0;
+        for (; (k & 1) == 1; k >>= 1)
+            ones++;
+        return ones;
+#endif
+    }
+
+public:
+    template<typename ITERATOR>
+    EytzingerSearchTree(ITERATOR first, ITERATOR last) {
+        build(std::vector<T>(first, last));
+    }
+
+    template<typename BALANCING>
+    explicit EytzingerSearchTree(const BinarySearchTree<T, BALANCING>& bst) {
+        build(static_search_tree::sorted_values(bst));
+    }
+
+    size_t size() const { return n; }
+
+    const T* lower_bound(const T& key) const {
+        size_t k = 1;
+        for (size_t level = 0; level < full_levels; level++)
+            k = step(k, key);
+        return finish(k, key);
+    }
+
+    bool contains(const T& key) const {
+        const T* found = lower_bound(key);
+        return found != nullptr && !(key < *found);
+    }
+
+    std::vector<const T*> lower_bound(const std::vector<T>& queries) const {
+        std::vector<const T*> results(queries.size());
+        size_t ks[batch_size];
+        for (size_t first = 0; first < queries.size(); first += batch_size) {
+            size_t count = std::min(batch_size, queries.size() - first);
+            std::fill(ks, ks + count, 1);
+            for (size_t level = 0; level < full_levels; level++)
+                for (size_t idx = 0; idx < count; idx++)
+                    ks[idx] = step(ks[idx], queries[first + idx]);
+            for (size_t idx = 0; idx < count; idx++)
+                results[first + idx] = finish(ks[idx], queries[first + idx]);
+        }
+        return results;
+    }
+
+    std::vector<char> contains(const std::vector<T>& queries) const {
+        std::vector<const T*> found = lower_bound(queries);
+        std::vector<char> results(queries.size());
+        for (size_t idx = 0; idx < queries.size(); idx++)
+            results[idx] = found[idx] != nullptr && !(queries[idx] < *found[idx]);
+        return results;
+    }
+};
+
+// The blocked (B-tree like) layout: every node is a sorted block of BLOCK_SIZE keys, one
+// cache line by default, and the children of block b are the blocks b * (BLOCK_SIZE + 1) + 1
+// to b * (BLOCK_SIZE + 1) + BLOCK_SIZE + 1. A lookup counts the keys of the block less than
+// the one looked up, which picks both the candidate answer and the child to go on with;
+// the count is a loop without branches, which compilers turn into SIMD comparisons. The
+// tree is log(BLOCK_SIZE + 1) times shallower than the Eytzinger one, so there are fewer
+// cache misses to wait for.
+//
+// The last block is padded with copies of the largest key, which never change an answer.
+template<typename T, size_t BLOCK_SIZE = static_search_tree::keys_per_line<T>()>
+class BlockedSearchTree {
+private:
+    static_assert(BLOCK_SIZE >= 1, "A block has to have at least one key.");
+
+    static constexpr size_t batch_size = 16;
+
+    std::vector<T, CacheAlignedAllocator<T>> keys;
+    size_t n;
+    size_t block_count;
+    size_t levels;
+
+    static size_t child(size_t block, size_t idx) { return block * (BLOCK_SIZE + 1) + idx + 1; }
+
+    size_t fill(const std::vector<T>& sorted, size_t next, size_t block) {
+        if (block < block_count) {
+            for (size_t idx = 0; idx < BLOCK_SIZE; idx++) {
+                next = fill(sorted, next, child(block, idx));
+                keys[block * BLOCK_SIZE + idx] = next < n ? sorted[next++] : sorted.back();
+            }
+            next = fill(sorted, next, child(block, BLOCK_SIZE));
+        }
+        return next;
+    }
+
+    void build(const std::vector<T>& sorted) {
+        static_search_tree::check_sorted(sorted);
+        n = sorted.size();
+        block_count = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        keys.resize(block_count * BLOCK_SIZE);
+        fill(sorted, 0, 0);
+        levels = 0;
+        for (size_t block = 0; block < block_count; block = child(block, 0))
+            levels++;
+    }
+
+    // the number of keys of the block less than key
+    size_t rank(size_t block, const T& key) const {
+        const T* block_keys = keys.data() + block * BLOCK_SIZE;
+        size_t count = 0;
+        for (size_t idx = 0; idx < BLOCK_SIZE; idx++)
+            count += block_keys[idx] < key;
+        return count;
+    }
+
+    size_t step(size_t block, const T& key, const T*& candidate) const {
+        size_t idx = rank(block, key);
+        if (idx < BLOCK_SIZE)
+            candidate = &keys[block * BLOCK_SIZE + idx];
+        return child(block, idx);
+    }
+
+public:
+    template<typename ITERATOR>
+    BlockedSearchTree(ITERATOR first, ITERATOR last) {
+        build(std::vector<T>(first, last));
+    }
+
+    template<typename BALANCING>
+    explicit BlockedSearchTree(const BinarySearchTree<T, BALANCING>& bst) {
+        build(static_search_tree::sorted_values(bst));
+    }
+
+    size_t size() const { return n; }
+
+    const T* lower_bound(const T& key) const {
+        const T* candidate = nullptr;
+        for (size_t block = 0; block < block_count;)
+            block = step(block, key, candidate);
+        return candidate;
+    }
+
+    bool contains(const T& key) const {
+        const T* found = lower_bound(key);
+        return found != nullptr && !(key < *found);
+    }
+
+    std::vector<const T*> lower_bound(const std::vector<T>& queries) const {
+        std::vector<const T*> results(queries.size(), nullptr);
+        size_t blocks[batch_size];
+        for (size_t first = 0; first < queries.size(); first += batch_size) {
+            size_t count = std::min(batch_size, queries.size() - first);
+            std::fill(blocks, blocks + count, 0);
+            for (size_t level = 0; level < levels; level++)
+                for (size_t idx = 0; idx < count; idx++)
+                    if (blocks[idx] < block_count)
+                        blocks[idx] = step(blocks[idx], queries[first + idx], results[first + idx]);
+        }
+        return results;
+    }
+
+    std::vector<char> contains(const std::vector<T>& queries) const {
+        std::vector<const T*> found = lower_bound(queries);
+        std::vector<char> results(queries.size());
+        for (size_t idx = 0; idx < queries.size(); idx++)
+            results[idx] = found[idx] != nullptr && !(queries[idx] < *found[idx]);
+        return results;
+    }
+};
+
+#endif //PLAYGROUND_STATICSEARCHTREE_HPP
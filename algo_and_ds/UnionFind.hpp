@@ -0,0 +1,58 @@
+#ifndef PLAYGROUND_UNIONFIND_HPP
+#define PLAYGROUND_UNIONFIND_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Disjoint sets over the elements [0, count), with union by rank and path compression,
+// so that any sequence of operations takes O(α(n)) amortized time per operation.
+class UnionFind {
+private:
+    std::vector<size_t> parents;
+    std::vector<unsigned char> ranks; // an upper bound on the height, never more than log2(count)
+    size_t set_count;
+
+public:
+    explicit UnionFind(size_t count) : parents(count), ranks(count, 0), set_count(count) {
+        for (size_t element = 0; element < count; element++)
+            parents[element] = element;
+    }
+
+    // the representative of the set of element; every element on the way is linked to it directly
+    size_t find(size_t element) {
+        size_t root = element;
+        while (parents[root] != root)
+            root = parents[root];
+        while (parents[element] != root) {
+            size_t parent = parents[element];
+            parents[element] = root;
+            element = parent;
+        }
+        return root;
+    }
+
+    // merges the sets of a and b, returns false if they were the same already
+    bool unite(size_t a, size_t b) {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+
+        if (ranks[a] < ranks[b])
+            std::swap(a, b);
+        parents[b] = a;
+        if (ranks[a] == ranks[b])
+            ranks[a]++;
+        set_count--;
+        return true;
+    }
+
+    bool same(size_t a, size_t b) { return find(a) == find(b); }
+
+    size_t size() const { return parents.size(); }
+
+    size_t setCount() const { return set_count; }
+};
+
+#endif //PLAYGROUND_UNIONFIND_HPP
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "BinarySearchTree.hpp"
+
+// Compares the balancing policies of BinarySearchTree on different orders of additions:
+//  - random:        the keys shuffled, which keeps even the unbalanced tree O(log n) deep
+//  - sorted:        the keys in increasing order, which makes the unbalanced tree a list
+//  - mostly sorted: sorted, but with every 100th key swapped with a random other one
+// Each run adds the N keys in the given order, then removes them in the same order.
+
+namespace {
+    template<typename F>
+    double measure(F&& f) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    template<typename BALANCING>
+    void run(const std::string& name, const std::vector<int>& keys) {
+        BinarySearchTree<int, BALANCING> tree;
+        double add_ms = measure([&] {
+            for (int key: keys)
+                tree.add(key);
+        });
+        double remove_ms = measure([&] {
+            for (int key: keys)
+                tree.remove(key);
+        });
+        std::cout << name << ":\tadd " << add_ms << " ms\tremove " << remove_ms << " ms" << std::endl;
+    }
+
+    void run_all(const std::string& order, const std::vector<int>& keys) {
+        std::cout << order << std::endl;
+        run<NoBalancing>("  unbalanced", keys);
+        run<AvlBalancing>("  AVL", keys);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // the unbalanced tree takes O(n^2) on sorted keys, so this is kept small by default
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+
+    std::mt19937 rng(69);
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+
+    std::vector<int> shuffled = sorted;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    std::vector<int> mostly_sorted = sorted;
+    for (size_t idx = 0; idx < n; idx += 100)
+        std::swap(mostly_sorted[idx], mostly_sorted[rng() % n]);
+
+    std::cout << "Binary search tree benchmark with " << n << " keys" << std::endl;
+    run_all("random", shuffled);
+    run_all("sorted", sorted);
+    run_all("mostly sorted", mostly_sorted);
+
+    return 0;
+}
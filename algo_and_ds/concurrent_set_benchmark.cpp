@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "ConcurrentSkipList.hpp"
+#include "../graphs/ThreadPool.hpp"
+
+// Compares the throughput of ConcurrentSkipList with a std::set behind a reader-writer
+// lock, every thread of a pool running the same number of random operations on keys from
+// [0, key range). The set is half full to begin with, and each mix is the percentage of
+// contains, add and remove calls.
+//
+// usage: ConcurrentSetBenchmark [thread count] [key range] [operations per thread]
+
+namespace {
+    struct Mix {
+        const char* name;
+        unsigned contains_percent;
+        unsigned add_percent; // the rest are removals
+    };
+
+    class LockedSet {
+    private:
+        std::set<int> set;
+        std::shared_mutex mutex;
+
+    public:
+        bool add(int key, size_t) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return set.insert(key).second;
+        }
+
+        bool remove(int key, size_t) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return set.erase(key) == 1;
+        }
+
+        bool contains(int key, size_t) {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return set.count(key) == 1;
+        }
+    };
+
+    // returns the operations per microsecond, along with the number of successful ones in checksum
+    template<typename SET>
+    double run(SET& set, ThreadPool& pool, Mix const& mix, int key_range, size_t operations, long long& checksum) {
+        for (int key = 0; key < key_range; key += 2)
+            set.add(key, 0);
+
+        std::vector<long long> successes(pool.size(), 0);
+        auto begin = std::chrono::steady_clock::now();
+        pool.run([&](size_t worker) {
+            std::mt19937 rng(worker + 1);
+            std::uniform_int_distribution<int> keys(0, key_range - 1);
+            std::uniform_int_distribution<unsigned> percents(0, 99);
+            long long succeeded = 0;
+            for (size_t idx = 0; idx < operations; idx++) {
+                int key = keys(rng);
+                unsigned percent = percents(rng);
+                if (percent < mix.contains_percent)
+                    succeeded += set.contains(key, worker);
+                else if (percent < mix.contains_percent + mix.add_percent)
+                    succeeded += set.add(key, worker);
+                else
+                    succeeded += set.remove(key, worker);
+            }
+            successes[worker] = succeeded;
+        });
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+        for (long long succeeded: successes)
+            checksum += succeeded;
+        return operations * pool.size() / us;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t thread_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    int key_range = argc > 2 ? std::atoi(argv[2]) : 1 << 20;
+    size_t operations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000000;
+    if (key_range <= 0) {
+        std::cerr << "The key range has to be positive" << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(thread_count);
+    std::cout << "Concurrent set benchmark with " << pool.size() << " threads, " << key_range << " keys, "
+              << operations << " operations per thread" << std::endl;
+
+    const std::vector<Mix> mixes = {
+            {"read-mostly (90/5/5)", 90, 5},
+            {"mixed (50/25/25)",     50, 25},
+            {"write-only (0/50/50)", 0,  50},
+    };
+    for (Mix const& mix: mixes) {
+        long long skip_list_checksum = 0, locked_checksum = 0;
+        double skip_list_throughput, locked_throughput;
+        {
+            ConcurrentSkipList<int> skip_list(pool.size());
+            skip_list_throughput = run(skip_list, pool, mix, key_range, operations, skip_list_checksum);
+        }
+        {
+            LockedSet locked;
+            locked_throughput = run(locked, pool, mix, key_range, operations, locked_checksum);
+        }
+        std::cout << mix.name << ":\tskip list " << skip_list_throughput << " Mops/s\tlocked std::set "
+                  << locked_throughput << " Mops/s\t(checksums " << skip_list_checksum << ", " << locked_checksum
+                  << ")" << std::endl;
+    }
+
+    return 0;
+}
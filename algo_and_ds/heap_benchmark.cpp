@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Heap.hpp"
+
+// Compares heaps of different arities on push/pop-heavy workloads:
+//  - fill:  N pushes, then N pops
+//  - bulk:  building a heap of N elements at once (bottom-up), then N pops
+//  - churn: starting from a heap of N elements, N rounds of one pop and one push
+//           (this is what a priority queue of e.g. Dijkstra's algorithm looks like)
+
+namespace {
+    template<size_t ARITY>
+    double fill_then_drain(const std::vector<int>& values, long long& checksum) {
+        auto begin = std::chrono::steady_clock::now();
+
+        MinHeap<int, ARITY> heap;
+        for (int value: values)
+            heap.insert(value);
+        while (!heap.empty()) {
+            checksum += heap.extreme();
+            heap.extreme_remove();
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    template<size_t ARITY>
+    double bulk_then_drain(const std::vector<int>& values, long long& checksum) {
+        auto begin = std::chrono::steady_clock::now();
+
+        MinHeap<int, ARITY> heap(values.begin(), values.end());
+        while (!heap.empty()) {
+            checksum += heap.extreme();
+            heap.extreme_remove();
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    template<size_t ARITY>
+    double churn(const std::vector<int>& values, long long& checksum) {
+        MinHeap<int, ARITY> heap;
+        for (int value: values)
+            heap.insert(value);
+
+        auto begin = std::chrono::steady_clock::now();
+
+        for (int value: values) {
+            int smallest = heap.extreme();
+            checksum += smallest;
+            heap.extreme_remove();
+            heap.insert(smallest + value % 1024); // keys grow monotonically, like distances do
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    template<size_t ARITY>
+    void run(const std::vector<int>& values) {
+        long long checksum = 0;
+        double fill_ms = fill_then_drain<ARITY>(values, checksum);
+        double bulk_ms = bulk_then_drain<ARITY>(values, checksum);
+        double churn_ms = churn<ARITY>(values, checksum);
+        std::cout << "arity " << ARITY << ":\tfill " << fill_ms << " ms\tbulk " << bulk_ms << " ms\tchurn " << churn_ms << " ms"
+                  << "\t(checksum " << checksum << ")" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937 rng(69);
+    std::uniform_int_distribution<int> dist(0, 1 << 30);
+    std::vector<int> values(n);
+    for (int& value: values)
+        value = dist(rng);
+
+    std::cout << "Heap benchmark with " << n << " elements" << std::endl;
+    run<2>(values);
+    run<4>(values);
+    run<8>(values);
+    run<16>(values);
+
+    return 0;
+}
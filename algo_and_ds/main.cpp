@@ -1,7 +1,10 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include "BPlusTree.hpp"
+#include "ConcurrentSkipList.hpp"
 #include "SegmentTree.hpp"
+#include "StaticSearchTree.hpp"
 
 void lexicographic_sort(std::vector<std::string>& strings, size_t k) {
     if (k == 0)
@@ -31,6 +34,14 @@ void lexicographic_sort(std::vector<std::string>& strings, size_t k) {
 //    bst.remove(5);
 //    std::cout << bst << std::endl;
 //
+//    EytzingerSearchTree<int> frozen(bst);
+//    std::cout << frozen.contains(5) << " " << *frozen.lower_bound(5) << std::endl;
+//
+//    std::vector<std::pair<int, std::string>> entries = {{1, "one"}, {2, "two"}, {3, "three"}, {5, "five"}};
+//    BPlusTree<int, std::string> map(entries.begin(), entries.end());
+//    map.insert(4, "four");
+//    map.scan(2, 5, [](int key, const std::string& value) { std::cout << key << ": " << value << std::endl; });
+//
 //    MinHeap<int> h = {5, 3, 7, 2, 1, 4, 6, 9, 8, 10};
 //    for (size_t i = 0; i < 10; i++) {
 //        std::cout << h.extreme() << " ";
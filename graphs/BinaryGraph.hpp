@@ -0,0 +1,197 @@
+#ifndef PLAYGROUND_BINARYGRAPH_HPP
+#define PLAYGROUND_BINARYGRAPH_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "CsrGraph.hpp"
+
+// The on-disk form of a CSR graph, laid out exactly the way it's used in memory:
+//
+//   header           (magic, version, node count, edge count)
+//   offsets          (node count + 1) x uint64
+//   arcs             (edge count) x {int32 to, int32 weight}
+//   reverse offsets  (node count + 1) x uint64
+//   reverse arcs     (edge count) x {int32 to, int32 weight}
+//
+// Everything is stored in native byte order; a file written on a machine of the
+// other endianness is rejected by the magic number check. Opening a file checks the
+// offsets and the arc targets in O(V + E), so a corrupted file is rejected up front
+// rather than read out of bounds later.
+struct BinaryGraphHeader {
+    static const uint32_t magic_number = 0x46524750; // "PGRF" read as a little-endian number
+    static const uint32_t current_version = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t node_count;
+    uint64_t edge_count;
+};
+
+static_assert(sizeof(CsrGraph::Arc) == 2 * sizeof(int32_t), "Arcs have to be packed for the binary format.");
+
+// Works on anything that has the interface of Graph, e.g. converting from the text format
+// is nothing more than reading a Graph (or a CsrGraph) then writing it out again.
+template<typename G>
+void write_binary_graph(std::ostream& os, G const& graph) {
+    uint64_t node_count = graph.nodeCount();
+
+    std::vector<uint64_t> offsets(node_count + 1, 0), reverse_offsets(node_count + 1, 0);
+    for (uint64_t node = 0; node < node_count; node++) {
+        offsets[node + 1] = offsets[node] + graph.edges(node).size();
+        reverse_offsets[node + 1] = reverse_offsets[node] + graph.reverse_edges(node).size();
+    }
+
+    BinaryGraphHeader header{BinaryGraphHeader::magic_number, BinaryGraphHeader::current_version, node_count,
+                             offsets.back()};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<CsrGraph::Arc> arcs;
+    os.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    for (uint64_t node = 0; node < node_count; node++) {
+        arcs.clear();
+        for (WeightedEdge const& edge: graph.edges(node))
+            arcs.push_back(CsrGraph::Arc{edge.to, edge.weight});
+        os.write(reinterpret_cast<const char*>(arcs.data()), arcs.size() * sizeof(CsrGraph::Arc));
+    }
+
+    os.write(reinterpret_cast<const char*>(reverse_offsets.data()), reverse_offsets.size() * sizeof(uint64_t));
+    for (uint64_t node = 0; node < node_count; node++) {
+        arcs.clear();
+        for (WeightedEdge const& edge: graph.reverse_edges(node))
+            arcs.push_back(CsrGraph::Arc{edge.to, edge.weight});
+        os.write(reinterpret_cast<const char*>(arcs.data()), arcs.size() * sizeof(CsrGraph::Arc));
+    }
+
+    if (!os)
+        throw std::runtime_error("Couldn't write the binary graph.");
+}
+
+// A read-only graph served straight from a memory-mapped binary graph file: nothing
+// is parsed or copied, the pages are loaded by the OS as the graph is traversed.
+// Opening only checks the header and the file size against its counts, so it takes
+// constant time. The offsets and arcs themselves are trusted; validate() checks them
+// too, reading the whole file, for files that may have been damaged or come from
+// elsewhere.
+class MappedGraph {
+private:
+    void* mapping;
+    size_t mapping_size;
+    uint64_t node_count;
+    uint64_t edge_count;
+    const uint64_t* offsets;
+    const CsrGraph::Arc* arcs;
+    const uint64_t* reverse_offsets;
+    const CsrGraph::Arc* reverse_arcs;
+
+    void unmap() {
+        if (mapping != nullptr)
+            munmap(mapping, mapping_size);
+        mapping = nullptr;
+    }
+
+    // compares the sizes by dividing rather than multiplying, so that no count in the header can overflow them
+    bool has_expected_size() const {
+        if (node_count >= static_cast<uint64_t>(INT_MAX)) // the ids have to fit into an int
+            return false;
+        size_t offsets_size = 2 * (node_count + 1) * sizeof(uint64_t);
+        size_t data_size = mapping_size - sizeof(BinaryGraphHeader);
+        if (data_size < offsets_size || (data_size - offsets_size) % (2 * sizeof(CsrGraph::Arc)) != 0)
+            return false;
+        return edge_count == (data_size - offsets_size) / (2 * sizeof(CsrGraph::Arc));
+    }
+
+    // the offsets have to go from 0 to edge_count without decreasing, and every arc has to lead to a node
+    bool is_consistent(const uint64_t* node_offsets, const CsrGraph::Arc* node_arcs) const {
+        if (node_offsets[0] != 0 || node_offsets[node_count] != edge_count)
+            return false;
+        for (uint64_t node = 0; node < node_count; node++)
+            if (node_offsets[node] > node_offsets[node + 1])
+                return false;
+        for (uint64_t arc = 0; arc < edge_count; arc++)
+            if (node_arcs[arc].to < 0 || static_cast<uint64_t>(node_arcs[arc].to) >= node_count)
+                return false;
+        return true;
+    }
+
+public:
+    explicit MappedGraph(const std::string& path) : mapping(nullptr), mapping_size(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Couldn't open " + path);
+
+        struct stat info;
+        if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(BinaryGraphHeader)) {
+            close(fd);
+            throw std::runtime_error(path + " isn't a binary graph file");
+        }
+
+        mapping_size = info.st_size;
+        mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps the file alive
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw std::runtime_error("Couldn't map " + path);
+        }
+
+        const BinaryGraphHeader* header = static_cast<const BinaryGraphHeader*>(mapping);
+        node_count = header->node_count;
+        edge_count = header->edge_count;
+        if (header->magic != BinaryGraphHeader::magic_number || header->version != BinaryGraphHeader::current_version ||
+            !has_expected_size()) {
+            unmap();
+            throw std::runtime_error(path + " isn't a binary graph file of a supported version");
+        }
+
+        const char* cursor = static_cast<const char*>(mapping) + sizeof(BinaryGraphHeader);
+        offsets = reinterpret_cast<const uint64_t*>(cursor);
+        cursor += (node_count + 1) * sizeof(uint64_t);
+        arcs = reinterpret_cast<const CsrGraph::Arc*>(cursor);
+        cursor += edge_count * sizeof(CsrGraph::Arc);
+        reverse_offsets = reinterpret_cast<const uint64_t*>(cursor);
+        cursor += (node_count + 1) * sizeof(uint64_t);
+        reverse_arcs = reinterpret_cast<const CsrGraph::Arc*>(cursor);
+    }
+
+    MappedGraph(const MappedGraph&) = delete;
+
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    MappedGraph(MappedGraph&& other) noexcept : mapping(other.mapping), mapping_size(other.mapping_size),
+                                                 node_count(other.node_count), edge_count(other.edge_count),
+                                                 offsets(other.offsets), arcs(other.arcs),
+                                                 reverse_offsets(other.reverse_offsets),
+                                                 reverse_arcs(other.reverse_arcs) {
+        other.mapping = nullptr;
+    }
+
+    ~MappedGraph() { unmap(); }
+
+    // O(V + E), touches every page of the file
+    void validate() const {
+        if (!is_consistent(offsets, arcs) || !is_consistent(reverse_offsets, reverse_arcs))
+            throw std::runtime_error("Corrupted binary graph file");
+    }
+
+    int nodeCount() const { return node_count; }
+
+    size_t edgeCount() const { return edge_count; }
+
+    CsrGraph::EdgeRange edges(int from) const {
+        return CsrGraph::EdgeRange(from, arcs + offsets[from], arcs + offsets[from + 1]);
+    }
+
+    CsrGraph::EdgeRange reverse_edges(int to) const {
+        return CsrGraph::EdgeRange(to, reverse_arcs + reverse_offsets[to], reverse_arcs + reverse_offsets[to + 1]);
+    }
+};
+
+#endif //PLAYGROUND_BINARYGRAPH_HPP
@@ -0,0 +1,397 @@
+#ifndef PLAYGROUND_CONTRACTIONHIERARCHY_HPP
+#define PLAYGROUND_CONTRACTIONHIERARCHY_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "ShortestPathQueries.hpp"
+#include "../algo_and_ds/IndexedHeap.hpp"
+
+// A contraction hierarchy: the nodes are contracted one by one in order of importance,
+// and whenever the only shortest path between two remaining neighbors of a contracted
+// node goes through it, a shortcut edge is added between them. A shortest path then
+// always exists that first climbs up to higher ranked nodes, then descends, so a query
+// is a bidirectional search where both sides only go upwards, settling a few hundred
+// nodes even on large road-like graphs.
+//
+// The upward graph has the edges (original and shortcut) from every node to the higher
+// ranked ones, the downward graph has the edges from the higher ranked ones into every
+// node, reversed (so its edges point upwards as well, for the backward search).
+//
+// The on-disk form (see write() and read()) is:
+//
+//   header            (magic, version, node count, upward edge count, downward edge count)
+//   ranks             (node count) x int32
+//   upward offsets    (node count + 1) x uint64
+//   upward arcs       (upward edge count) x {int32 to, int32 weight}
+//   downward offsets  (node count + 1) x uint64
+//   downward arcs     (downward edge count) x {int32 to, int32 weight}
+class ContractionHierarchy {
+private:
+    struct Header {
+        static const uint32_t magic_number = 0x48434750; // "PGCH" read as a little-endian number
+        static const uint32_t current_version = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint64_t node_count;
+        uint64_t upward_count;
+        uint64_t downward_count;
+    };
+
+    // witness searches give up after settling this many nodes, and a shortcut is added
+    // instead: it's never wrong to add one, just superfluous at times
+    static const int witness_settle_limit = 500;
+
+    std::vector<int> ranks;
+    CsrGraph upward;
+    CsrGraph downward;
+
+    // the graph of the nodes not contracted yet, as it's being contracted
+    class Contraction {
+    private:
+        std::vector<std::vector<CsrGraph::Arc>> outgoing;
+        std::vector<std::vector<CsrGraph::Arc>> incoming; // arc.to is the node the edge comes from
+        std::vector<int> deleted_neighbors;
+        DijkstraScratch witness;
+        std::vector<unsigned> target_generations; // the targets of the current witness search are marked
+
+        // adds from -> to, or lowers the weight of the existing one
+        void add_edge(int from, int to, int weight) {
+            for (CsrGraph::Arc& arc: outgoing[from]) {
+                if (arc.to == to) {
+                    if (weight < arc.weight) {
+                        arc.weight = weight;
+                        for (CsrGraph::Arc& rev_arc: incoming[to])
+                            if (rev_arc.to == from)
+                                rev_arc.weight = weight;
+                    }
+                    return;
+                }
+            }
+            outgoing[from].push_back(CsrGraph::Arc{to, weight});
+            incoming[to].push_back(CsrGraph::Arc{from, weight});
+        }
+
+        static void remove_arcs_to(std::vector<CsrGraph::Arc>& arcs, int to) {
+            arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [&](CsrGraph::Arc const& arc) { return arc.to == to; }),
+                       arcs.end());
+        }
+
+        // Dijkstra from source avoiding the node being contracted, up to limit or until the
+        // successors of the contracted node are all settled
+        void witness_search(int source, int avoided, int limit) {
+            witness.next_query();
+            witness.set_distance(source, 0);
+            witness.next_nodes.insert(source, 0);
+
+            int remaining_targets = 0;
+            for (CsrGraph::Arc const& out: outgoing[avoided]) {
+                if (out.to != source && target_generations[out.to] != witness.generation) {
+                    target_generations[out.to] = witness.generation;
+                    remaining_targets++;
+                }
+            }
+
+            int settled = 0;
+            while (!witness.next_nodes.empty() && settled++ < witness_settle_limit) {
+                int distance_to_node = witness.next_nodes.extreme();
+                if (distance_to_node > limit)
+                    break;
+                int node = witness.next_nodes.extreme_key();
+                witness.next_nodes.extreme_remove();
+                if (target_generations[node] == witness.generation && --remaining_targets == 0)
+                    break;
+
+                for (CsrGraph::Arc const& arc: outgoing[node]) {
+                    if (arc.to == avoided)
+                        continue;
+                    int distance = distance_to_node + arc.weight;
+                    if (distance < witness.distance(arc.to)) {
+                        witness.set_distance(arc.to, distance);
+                        witness.next_nodes.update(arc.to, distance);
+                    }
+                }
+            }
+        }
+
+        // the number of shortcuts contracting node needs, which are also added unless simulating
+        int shortcut(int node, bool simulate) {
+            int shortcut_count = 0;
+            for (CsrGraph::Arc const& in: incoming[node]) {
+                int limit = -1;
+                for (CsrGraph::Arc const& out: outgoing[node])
+                    if (out.to != in.to)
+                        limit = std::max(limit, in.weight + out.weight);
+                if (limit == -1)
+                    continue;
+
+                witness_search(in.to, node, limit);
+                for (CsrGraph::Arc const& out: outgoing[node]) {
+                    if (out.to == in.to || witness.distance(out.to) <= in.weight + out.weight)
+                        continue;
+                    shortcut_count++;
+                    if (!simulate)
+                        add_edge(in.to, out.to, in.weight + out.weight);
+                }
+            }
+            return shortcut_count;
+        }
+
+    public:
+        template<typename G>
+        explicit Contraction(G const& graph) : outgoing(graph.nodeCount()), incoming(graph.nodeCount()),
+                                               deleted_neighbors(graph.nodeCount(), 0), witness(graph.nodeCount()),
+                                               target_generations(graph.nodeCount(), 0) {
+            for (int node = 0; node < graph.nodeCount(); node++)
+                for (WeightedEdge const& edge: graph.edges(node))
+                    if (edge.to != node)
+                        add_edge(node, edge.to, edge.weight);
+        }
+
+        std::vector<CsrGraph::Arc> const& outgoing_arcs(int node) const { return outgoing[node]; }
+
+        std::vector<CsrGraph::Arc> const& incoming_arcs(int node) const { return incoming[node]; }
+
+        // the edge difference (weighted double), plus the number of neighbors contracted already to spread the
+        // contraction evenly over the graph
+        int priority(int node) {
+            return 2 * shortcut(node, true) - 2 * static_cast<int>(incoming[node].size() + outgoing[node].size()) +
+                   deleted_neighbors[node];
+        }
+
+        // adds the shortcuts, then takes node out of the graph (it's up to the caller to save its arcs first)
+        void contract(int node) {
+            shortcut(node, false);
+            for (CsrGraph::Arc const& out: outgoing[node]) {
+                remove_arcs_to(incoming[out.to], node);
+                deleted_neighbors[out.to]++;
+            }
+            for (CsrGraph::Arc const& in: incoming[node]) {
+                remove_arcs_to(outgoing[in.to], node);
+                deleted_neighbors[in.to]++;
+            }
+            std::vector<CsrGraph::Arc>().swap(outgoing[node]);
+            std::vector<CsrGraph::Arc>().swap(incoming[node]);
+        }
+    };
+
+    static CsrGraph to_csr(std::vector<std::vector<CsrGraph::Arc>> const& arcs_of_nodes) {
+        std::vector<size_t> offsets(arcs_of_nodes.size() + 1, 0);
+        for (size_t node = 0; node < arcs_of_nodes.size(); node++)
+            offsets[node + 1] = offsets[node] + arcs_of_nodes[node].size();
+        std::vector<CsrGraph::Arc> arcs;
+        arcs.reserve(offsets.back());
+        for (std::vector<CsrGraph::Arc> const& node_arcs: arcs_of_nodes)
+            arcs.insert(arcs.end(), node_arcs.begin(), node_arcs.end());
+        return CsrGraph(std::move(offsets), std::move(arcs));
+    }
+
+    template<typename G>
+    void contract_nodes(G const& graph) {
+        int node_count = graph.nodeCount();
+        Contraction contraction(graph);
+        std::vector<std::vector<CsrGraph::Arc>> upward_arcs(node_count), downward_arcs(node_count);
+
+        MinIndexedHeap<int> queue(node_count);
+        for (int node = 0; node < node_count; node++)
+            queue.insert(node, contraction.priority(node));
+
+        ranks.assign(node_count, -1);
+        std::vector<int> neighbors;
+        for (int rank = 0; !queue.empty();) {
+            // lazy updates: the priority of the best node may be stale, only contract it if it's still the best
+            int node = static_cast<int>(queue.extreme_key());
+            queue.update(node, contraction.priority(node));
+            int best = static_cast<int>(queue.extreme_key());
+            if (best != node)
+                continue;
+            queue.extreme_remove();
+            ranks[node] = rank++;
+
+            neighbors.clear();
+            for (CsrGraph::Arc const& out: contraction.outgoing_arcs(node))
+                neighbors.push_back(out.to);
+            for (CsrGraph::Arc const& in: contraction.incoming_arcs(node))
+                neighbors.push_back(in.to);
+
+            upward_arcs[node] = contraction.outgoing_arcs(node);
+            downward_arcs[node] = contraction.incoming_arcs(node);
+            contraction.contract(node);
+
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+            for (int neighbor: neighbors)
+                queue.update(neighbor, contraction.priority(neighbor));
+        }
+
+        upward = to_csr(upward_arcs);
+        downward = to_csr(downward_arcs);
+    }
+
+    static void write_csr(std::ostream& os, CsrGraph const& graph) {
+        std::vector<uint64_t> offsets(graph.nodeCount() + 1, 0);
+        for (int node = 0; node < graph.nodeCount(); node++)
+            offsets[node + 1] = offsets[node] + graph.edges(node).size();
+        os.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+
+        std::vector<CsrGraph::Arc> arcs;
+        for (int node = 0; node < graph.nodeCount(); node++)
+            for (WeightedEdge const& edge: graph.edges(node))
+                arcs.push_back(CsrGraph::Arc{edge.to, edge.weight});
+        os.write(reinterpret_cast<const char*>(arcs.data()), arcs.size() * sizeof(CsrGraph::Arc));
+    }
+
+    static CsrGraph read_csr(std::istream& is, uint64_t node_count, uint64_t edge_count) {
+        std::vector<uint64_t> file_offsets(node_count + 1);
+        std::vector<CsrGraph::Arc> arcs(edge_count);
+        is.read(reinterpret_cast<char*>(file_offsets.data()), file_offsets.size() * sizeof(uint64_t));
+        is.read(reinterpret_cast<char*>(arcs.data()), arcs.size() * sizeof(CsrGraph::Arc));
+        if (!is)
+            throw std::runtime_error("Truncated contraction hierarchy.");
+
+        std::vector<size_t> offsets(file_offsets.begin(), file_offsets.end());
+        if (offsets[0] != 0 || offsets.back() != edge_count)
+            throw std::runtime_error("Corrupt contraction hierarchy.");
+        for (uint64_t node = 0; node < node_count; node++)
+            if (offsets[node] > offsets[node + 1])
+                throw std::runtime_error("Corrupt contraction hierarchy.");
+        for (CsrGraph::Arc const& arc: arcs)
+            if (arc.to < 0 || static_cast<uint64_t>(arc.to) >= node_count)
+                throw std::runtime_error("Corrupt contraction hierarchy.");
+        return CsrGraph(std::move(offsets), std::move(arcs));
+    }
+
+    ContractionHierarchy() = default;
+
+public:
+    int nodeCount() const { return static_cast<int>(ranks.size()); }
+
+    std::vector<int> const& getRanks() const { return ranks; }
+
+    CsrGraph const& getUpward() const { return upward; }
+
+    CsrGraph const& getDownward() const { return downward; }
+
+    // the original edges (without self-loops, and parallel ones merged) and the shortcuts
+    size_t edgeCount() const { return upward.edgeCount() + downward.edgeCount(); }
+
+    template<typename G = Graph>
+    static ContractionHierarchy build(G const& graph) {
+        ContractionHierarchy hierarchy;
+        hierarchy.contract_nodes(graph);
+        return hierarchy;
+    }
+
+    void write(std::ostream& os) const {
+        Header header{Header::magic_number, Header::current_version, ranks.size(), upward.edgeCount(),
+                      downward.edgeCount()};
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os.write(reinterpret_cast<const char*>(ranks.data()), ranks.size() * sizeof(int));
+        write_csr(os, upward);
+        write_csr(os, downward);
+
+        if (!os)
+            throw std::runtime_error("Couldn't write the contraction hierarchy.");
+    }
+
+    static ContractionHierarchy read(std::istream& is) {
+        Header header;
+        if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            throw std::runtime_error("Truncated contraction hierarchy.");
+        if (header.magic != Header::magic_number)
+            throw std::runtime_error("Not a contraction hierarchy (or of the wrong byte order).");
+        if (header.version != Header::current_version)
+            throw std::runtime_error("Unsupported contraction hierarchy version.");
+        if (header.node_count > INT_MAX)
+            throw std::runtime_error("Corrupt contraction hierarchy.");
+
+        ContractionHierarchy hierarchy;
+        hierarchy.ranks.resize(header.node_count);
+        if (!is.read(reinterpret_cast<char*>(hierarchy.ranks.data()), hierarchy.ranks.size() * sizeof(int)))
+            throw std::runtime_error("Truncated contraction hierarchy.");
+        hierarchy.upward = read_csr(is, header.node_count, header.upward_count);
+        hierarchy.downward = read_csr(is, header.node_count, header.downward_count);
+        return hierarchy;
+    }
+};
+
+// Answers shortest distance queries on a contraction hierarchy. It owns the scratch space
+// of the two searches, so it must not be used from several threads at once: every thread
+// should have an engine of its own (the hierarchy itself can be shared).
+class ContractionHierarchyQuery {
+private:
+    ContractionHierarchy const& hierarchy;
+    DijkstraScratch forward;
+    DijkstraScratch backward;
+
+public:
+    explicit ContractionHierarchyQuery(ContractionHierarchy const& hierarchy)
+            : hierarchy(hierarchy), forward(hierarchy.nodeCount()), backward(hierarchy.nodeCount()) {}
+
+    // the same as DijkstraInfo::dijkstra(graph, source).getDistances()[target] on the original graph
+    int distance(int source, int target) {
+        forward.next_query();
+        backward.next_query();
+        forward.set_distance(source, 0);
+        forward.next_nodes.insert(source, 0);
+        backward.set_distance(target, 0);
+        backward.next_nodes.insert(target, 0);
+
+        // unlike plain bidirectional Dijkstra, both sides have to go on until they can't improve on best:
+        // the searches only go upwards, so the first node reached from both sides isn't necessarily on the path
+        int best = INT_MAX;
+        while (!forward.next_nodes.empty() || !backward.next_nodes.empty()) {
+            bool forward_turn = backward.next_nodes.empty() ||
+                                (!forward.next_nodes.empty() &&
+                                 forward.next_nodes.extreme() <= backward.next_nodes.extreme());
+            DijkstraScratch& search = forward_turn ? forward : backward;
+            DijkstraScratch const& other = forward_turn ? backward : forward;
+
+            int distance_to_node = search.next_nodes.extreme();
+            if (distance_to_node >= best) {
+                search.next_nodes.clear(); // this side is done
+                continue;
+            }
+            int node = search.next_nodes.extreme_key();
+            search.next_nodes.extreme_remove();
+
+            int remaining = other.distance(node);
+            if (remaining != INT_MAX)
+                best = std::min(best, distance_to_node + remaining);
+
+            // stall-on-demand: if a higher ranked node reached already leads to node on a shorter path,
+            // node isn't on any shortest path of this search, so there's no point in going on from it
+            bool stalled = false;
+            for (WeightedEdge const& edge: forward_turn ? hierarchy.getDownward().edges(node)
+                                                        : hierarchy.getUpward().edges(node)) {
+                int distance_to_higher = search.distance(edge.to);
+                if (distance_to_higher != INT_MAX && distance_to_higher + edge.weight < distance_to_node) {
+                    stalled = true;
+                    break;
+                }
+            }
+            if (stalled)
+                continue;
+
+            for (WeightedEdge const& edge: forward_turn ? hierarchy.getUpward().edges(node)
+                                                        : hierarchy.getDownward().edges(node)) {
+                int distance = distance_to_node + edge.weight;
+                if (distance < search.distance(edge.to)) {
+                    search.set_distance(edge.to, distance);
+                    search.next_nodes.update(edge.to, distance);
+                }
+            }
+        }
+
+        return best;
+    }
+};
+
+#endif //PLAYGROUND_CONTRACTIONHIERARCHY_HPP
@@ -0,0 +1,141 @@
+#ifndef PLAYGROUND_CSRGRAPH_HPP
+#define PLAYGROUND_CSRGRAPH_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+
+// A frozen graph in compressed sparse row form: the outgoing arcs of every node
+// live in one contiguous array, and offsets[node]..offsets[node + 1] delimit them.
+// The same is done for the incoming arcs, so reverse_edges() is just as cheap.
+//
+// Only the target and the weight is stored per arc, the source is implied by the
+// slice the arc lives in, and it's handed out again when iterating the edges.
+class CsrGraph {
+public:
+    struct Arc {
+        int to;
+        int weight;
+    };
+
+    class EdgeRange {
+    private:
+        int from;
+        const Arc* first;
+        const Arc* last;
+    public:
+        class iterator {
+        private:
+            int from;
+            const Arc* ptr;
+        public:
+            iterator(int from, const Arc* ptr) : from(from), ptr(ptr) {}
+
+            // edges are materialized on the fly, so that code written against Graph keeps working
+            WeightedEdge operator*() const { return WeightedEdge(from, ptr->to, ptr->weight); }
+
+            iterator& operator++() {
+                ++ptr;
+                return *this;
+            }
+
+            bool operator==(iterator rhs) const { return ptr == rhs.ptr; }
+
+            bool operator!=(iterator rhs) const { return ptr != rhs.ptr; }
+        };
+
+        EdgeRange(int from, const Arc* first, const Arc* last) : from(from), first(first), last(last) {}
+
+        iterator begin() const { return iterator(from, first); }
+
+        iterator end() const { return iterator(from, last); }
+
+        size_t size() const { return last - first; }
+
+        bool empty() const { return first == last; }
+
+        WeightedEdge operator[](size_t idx) const { return WeightedEdge(from, first[idx].to, first[idx].weight); }
+    };
+
+private:
+    std::vector<size_t> offsets;
+    std::vector<Arc> arcs;
+    std::vector<size_t> reverse_offsets;
+    std::vector<Arc> reverse_arcs;
+
+    // counting sort of the forward arcs by their target
+    void build_reverse() {
+        int node_count = nodeCount();
+        reverse_offsets.assign(node_count + 1, 0);
+        for (const Arc& arc: arcs)
+            reverse_offsets[arc.to + 1]++;
+        for (int node = 0; node < node_count; node++)
+            reverse_offsets[node + 1] += reverse_offsets[node];
+
+        reverse_arcs.resize(arcs.size());
+        std::vector<size_t> cursor(reverse_offsets.begin(), reverse_offsets.end() - 1);
+        for (int from = 0; from < node_count; from++)
+            for (size_t idx = offsets[from]; idx < offsets[from + 1]; idx++)
+                reverse_arcs[cursor[arcs[idx].to]++] = Arc{from, arcs[idx].weight};
+    }
+
+public:
+    CsrGraph() : offsets(1, 0), reverse_offsets(1, 0) {}
+
+    explicit CsrGraph(Graph const& graph) : offsets(graph.nodeCount() + 1, 0) {
+        for (int from = 0; from < graph.nodeCount(); from++)
+            offsets[from + 1] = offsets[from] + graph.edges(from).size();
+
+        arcs.reserve(offsets.back());
+        for (int from = 0; from < graph.nodeCount(); from++)
+            for (WeightedEdge const& edge: graph.edges(from))
+                arcs.push_back(Arc{edge.to, edge.weight});
+
+        build_reverse();
+    }
+
+    // takes over ready-made forward arrays (offsets has node count + 1 entries), the reverse ones are derived
+    CsrGraph(std::vector<size_t> offsets, std::vector<Arc> arcs) : offsets(std::move(offsets)), arcs(std::move(arcs)) {
+        build_reverse();
+    }
+
+    int nodeCount() const { return offsets.size() - 1; }
+
+    size_t edgeCount() const { return arcs.size(); }
+
+    EdgeRange edges(int from) const {
+        return EdgeRange(from, arcs.data() + offsets[from], arcs.data() + offsets[from + 1]);
+    }
+
+    EdgeRange reverse_edges(int to) const {
+        return EdgeRange(to, reverse_arcs.data() + reverse_offsets[to], reverse_arcs.data() + reverse_offsets[to + 1]);
+    }
+
+    friend std::istream& operator>>(std::istream& is, CsrGraph& g);
+};
+
+// Reads the very same format as Graph does, but since the records come in the
+// order of their source nodes, the forward arrays can be filled in one pass.
+inline std::istream& operator>>(std::istream& is, CsrGraph& g) {
+    int node_count;
+    is >> node_count;
+    g.offsets.assign(node_count + 1, 0);
+    g.arcs.clear();
+    for (int from = 0; from < node_count; from++) {
+        int edge_count;
+        is >> edge_count;
+        for (int count = 0; count < edge_count; count++) {
+            int to, weight;
+            is >> to >> weight;
+            g.arcs.push_back(CsrGraph::Arc{to, weight});
+        }
+        g.offsets[from + 1] = g.arcs.size();
+    }
+    g.arcs.shrink_to_fit();
+    g.build_reverse();
+    return is;
+}
+
+#endif //PLAYGROUND_CSRGRAPH_HPP
@@ -0,0 +1,152 @@
+#ifndef PLAYGROUND_DELTASTEPPING_HPP
+#define PLAYGROUND_DELTASTEPPING_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+// Parallel single-source shortest paths by delta-stepping (Meyer & Sanders).
+//
+// The tentative distances are sorted into buckets of width delta. The nodes of the
+// lowest non-empty bucket are processed together: first their light edges (weight
+// <= delta) are relaxed in parallel, repeatedly, as these may refill the very same
+// bucket, then, once it's settled for good, their heavy edges are relaxed once.
+// Distances are lowered with an atomic compare-and-swap, so concurrent relaxations
+// of the same node are fine, and the result equals the one of DijkstraInfo.
+//
+// Only the non-empty buckets are kept, in a map ordered by index, so the memory and the
+// time spent on buckets don't depend on the largest distance over delta: long ranges of
+// empty buckets (e.g. beyond a single very heavy edge) are skipped for free.
+template<typename G = Graph>
+class DeltaSteppingInfo {
+private:
+    G const& graph;
+    ThreadPool& pool;
+    int delta;
+    std::vector<std::atomic<int>> current_bests;
+    std::map<int, std::vector<int>> buckets; // the non-empty ones, by index
+    std::map<int, std::vector<int>>::iterator last_filed; // most nodes go to the same bucket as the one before
+    std::vector<std::vector<int>> requests;   // the nodes improved by each worker in the current phase
+    std::vector<char> queued;                 // whether a node is in the frontier or in the settled list already
+    std::vector<int> distances;
+
+    DeltaSteppingInfo(G const& graph, ThreadPool& pool, int delta)
+            : graph(graph), pool(pool), delta(delta), current_bests(graph.nodeCount()), requests(pool.size()),
+              queued(graph.nodeCount(), false) {
+        last_filed = buckets.end();
+        for (std::atomic<int>& best: current_bests)
+            best.store(INT_MAX, std::memory_order_relaxed);
+    }
+
+    static bool lower(std::atomic<int>& best, int distance) {
+        int current = best.load(std::memory_order_relaxed);
+        while (distance < current)
+            if (best.compare_exchange_weak(current, distance, std::memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    void put(int node) {
+        int bucket = current_bests[node].load(std::memory_order_relaxed) / delta;
+        if (last_filed == buckets.end() || last_filed->first != bucket)
+            last_filed = buckets.try_emplace(bucket).first;
+        last_filed->second.push_back(node);
+    }
+
+    // relaxes the light or the heavy edges of the given nodes in parallel, then files the improved nodes
+    void relax(std::vector<int> const& nodes, bool light) {
+        pool.parallel_for(0, nodes.size(), [&](size_t idx, size_t worker) {
+            int node = nodes[idx];
+            int distance_to_node = current_bests[node].load(std::memory_order_relaxed);
+            for (WeightedEdge const& edge: graph.edges(node))
+                if ((edge.weight <= delta) == light && lower(current_bests[edge.to], distance_to_node + edge.weight))
+                    requests[worker].push_back(edge.to);
+        }, 64);
+
+        for (std::vector<int>& improved: requests) {
+            for (int node: improved)
+                put(node);
+            improved.clear();
+        }
+    }
+
+    void delta_stepping(int start) {
+        current_bests[start].store(0, std::memory_order_relaxed);
+        put(start);
+
+        std::vector<int> frontier;
+        std::vector<int> settled;
+        while (!buckets.empty()) {
+            // relaxing light edges only refills this bucket or files nodes into later ones, so it stays the first
+            auto current = buckets.begin();
+            int bucket = current->first;
+            std::vector<int>& nodes = current->second;
+            while (!nodes.empty()) {
+                // a node may have been filed more than once, or may have moved to a lower bucket since
+                frontier.clear();
+                for (int node: nodes) {
+                    if (!queued[node] && current_bests[node].load(std::memory_order_relaxed) / delta == bucket) {
+                        queued[node] = true;
+                        frontier.push_back(node);
+                    }
+                }
+                nodes.clear();
+                for (int node: frontier)
+                    queued[node] = false;
+
+                relax(frontier, true);
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+            }
+
+            // a node may have been processed more than once in this bucket, but it's enough to relax its heavy edges once
+            frontier.clear();
+            for (int node: settled) {
+                if (!queued[node]) {
+                    queued[node] = true;
+                    frontier.push_back(node);
+                }
+            }
+            for (int node: frontier)
+                queued[node] = false;
+            settled.clear();
+
+            relax(frontier, false); // heavy edges lead beyond this bucket
+            buckets.erase(current);
+            last_filed = buckets.end();
+        }
+
+        distances.resize(graph.nodeCount());
+        for (int node = 0; node < graph.nodeCount(); node++)
+            distances[node] = current_bests[node].load(std::memory_order_relaxed);
+    }
+
+public:
+    std::vector<int> const& getDistances() const { return distances; }
+
+    static DeltaSteppingInfo delta_stepping(G const& graph, int start, int delta, ThreadPool& pool) {
+        DeltaSteppingInfo deltaSteppingInfo(graph, pool, delta > 0 ? delta : 1);
+        deltaSteppingInfo.delta_stepping(start);
+        return deltaSteppingInfo;
+    }
+
+    // picks delta as the maximum weight over the average degree, a usual rule of thumb
+    static DeltaSteppingInfo delta_stepping(G const& graph, int start, ThreadPool& pool) {
+        long long edge_count = 0;
+        int max_weight = 0;
+        for (int node = 0; node < graph.nodeCount(); node++) {
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                edge_count++;
+                if (edge.weight > max_weight)
+                    max_weight = edge.weight;
+            }
+        }
+        long long average_degree = graph.nodeCount() == 0 ? 1 : edge_count / graph.nodeCount() + 1;
+        return delta_stepping(graph, start, static_cast<int>(max_weight / average_degree), pool);
+    }
+};
+
+#endif //PLAYGROUND_DELTASTEPPING_HPP
@@ -0,0 +1,123 @@
+#ifndef PLAYGROUND_DYNAMICSHORTESTPATHS_HPP
+#define PLAYGROUND_DYNAMICSHORTESTPATHS_HPP
+
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "Graph.hpp"
+#include "../algo_and_ds/IndexedHeap.hpp"
+
+// The distances from a source (the ones of BfsInfo or DijkstraInfo, depending on the
+// metric), kept up to date while batches of edges are added to and removed from the graph.
+//
+// A shortest path tree is kept along with the distances. Removing an edge of the tree
+// cuts off the subtree below it: only the nodes in there may get farther, so only they
+// are reset, then each is offered the best edge into it from the rest of the graph.
+// Adding an edge that leads somewhere on a shorter path improves its target. Either
+// way, the changed nodes are passed on to a Dijkstra that settles only what changes.
+//
+// Only the distances are maintained: unlike BfsInfo, no order of visits is kept.
+class DynamicShortestPaths {
+public:
+    enum class Metric {
+        HOPS,   // every edge counts as one, as in BfsInfo
+        WEIGHTS // as in DijkstraInfo, the weights mustn't be negative
+    };
+
+private:
+    Graph& graph;
+    int source;
+    Metric metric;
+    std::vector<int> distances;
+    std::vector<int> parents; // in the shortest path tree, -1 for the source and the unreachable nodes
+    std::vector<char> affected;
+    MinIndexedHeap<int> next_nodes;
+
+    int length(WeightedEdge const& edge) const { return metric == Metric::HOPS ? 1 : edge.weight; }
+
+    void improve(int node, int parent, int distance) {
+        distances[node] = distance;
+        parents[node] = parent;
+        next_nodes.update(node, distance);
+    }
+
+    void propagate() {
+        while (!next_nodes.empty()) {
+            int node = next_nodes.extreme_key();
+            next_nodes.extreme_remove();
+
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                int distance = distances[node] + length(edge);
+                if (distance < distances[edge.to])
+                    improve(edge.to, node, distance);
+            }
+        }
+    }
+
+public:
+    DynamicShortestPaths(Graph& graph, int source, Metric metric)
+            : graph(graph), source(source), metric(metric), distances(graph.nodeCount(), INT_MAX),
+              parents(graph.nodeCount(), -1), affected(graph.nodeCount(), false), next_nodes(graph.nodeCount()) {
+        improve(source, -1, 0);
+        propagate();
+    }
+
+    int getSource() const { return source; }
+
+    std::vector<int> const& getDistances() const { return distances; }
+
+    std::vector<int> const& getParents() const { return parents; }
+
+    // applies the batch to the graph (see Graph::add_edges and Graph::remove_edges), then
+    // repairs the distances; returns the number of nodes that had to be reset
+    size_t update(std::vector<WeightedEdge> const& added, std::vector<WeightedEdge> const& removed) {
+        for (WeightedEdge const& edge: added) // so that the graph isn't left half updated
+            if (edge.from < 0 || edge.from >= graph.nodeCount() || edge.to < 0 || edge.to >= graph.nodeCount())
+                throw std::runtime_error("No such node");
+        graph.remove_edges(removed);
+        graph.add_edges(added);
+
+        // the subtrees hanging from the removed tree edges (the edge may have had a tight parallel
+        // twin, which the edges offered below will find)
+        std::vector<int> reset;
+        for (WeightedEdge const& edge: removed) {
+            if (parents[edge.to] == edge.from && !affected[edge.to] && distances[edge.from] != INT_MAX &&
+                distances[edge.from] + length(edge) == distances[edge.to]) {
+                affected[edge.to] = true;
+                reset.push_back(edge.to);
+            }
+        }
+        for (size_t idx = 0; idx < reset.size(); idx++) {
+            for (WeightedEdge const& edge: graph.edges(reset[idx])) {
+                if (parents[edge.to] == reset[idx] && !affected[edge.to]) {
+                    affected[edge.to] = true;
+                    reset.push_back(edge.to);
+                }
+            }
+        }
+        for (int node: reset) {
+            distances[node] = INT_MAX;
+            parents[node] = -1;
+        }
+
+        for (int node: reset) {
+            for (WeightedEdge const& rev_edge: graph.reverse_edges(node)) {
+                int from = rev_edge.to;
+                if (!affected[from] && distances[from] != INT_MAX && distances[from] + length(rev_edge) < distances[node])
+                    improve(node, from, distances[from] + length(rev_edge));
+            }
+        }
+        for (int node: reset)
+            affected[node] = false;
+
+        for (WeightedEdge const& edge: added)
+            if (distances[edge.from] != INT_MAX && distances[edge.from] + length(edge) < distances[edge.to])
+                improve(edge.to, edge.from, distances[edge.from] + length(edge));
+
+        propagate();
+        return reset.size();
+    }
+};
+
+#endif //PLAYGROUND_DYNAMICSHORTESTPATHS_HPP
@@ -0,0 +1,152 @@
+#ifndef PLAYGROUND_GRAPH_HPP
+#define PLAYGROUND_GRAPH_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+struct Edge {
+    int from, to;
+
+    explicit Edge(int from = 0, int to = 0) : from(from), to(to) {}
+};
+
+struct WeightedEdge : public Edge {
+    int weight;
+
+    explicit WeightedEdge(int from = 0, int to = 0, int weight = 0) : Edge(from, to), weight(weight) {}
+
+    bool operator<(const WeightedEdge& other) const { return weight < other.weight; }
+
+    bool operator>(const WeightedEdge& other) const { return weight > other.weight; }
+
+    bool operator==(const WeightedEdge& other) const { return weight == other.weight; }
+
+    bool operator!=(const WeightedEdge& other) const { return weight != other.weight; }
+
+    bool operator<=(const WeightedEdge& other) const { return weight <= other.weight; }
+
+    bool operator>=(const WeightedEdge& other) const { return weight >= other.weight; }
+};
+
+class Graph {
+private:
+    std::vector<std::vector<WeightedEdge>> edge_list;
+    std::vector<std::vector<WeightedEdge>> reverse_edge_list;
+
+    // Finds an edge of lists[node] for every removal (a distinct one for removals that are the
+    // same) and marks it in the returned flags, without modifying anything yet. The removals
+    // are (node, other end, weight) triples sorted, [first, last) being those of node, so they
+    // are matched in one pass against the edges of the list sorted the same way.
+    template<typename It>
+    static std::vector<char> find_removed(std::vector<WeightedEdge> const& list, It first, It last) {
+        std::vector<size_t> order(list.size());
+        for (size_t idx = 0; idx < list.size(); idx++)
+            order[idx] = idx;
+        auto key = [&](size_t idx) { return std::make_pair(list[idx].to, list[idx].weight); };
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return std::make_pair(key(lhs), lhs) < std::make_pair(key(rhs), rhs);
+        });
+
+        std::vector<char> removed(list.size(), false);
+        size_t pos = 0;
+        for (It removal = first; removal != last; ++removal) {
+            auto wanted = std::make_pair(std::get<1>(*removal), std::get<2>(*removal));
+            while (pos < order.size() && key(order[pos]) < wanted)
+                pos++;
+            if (pos == order.size() || key(order[pos]) != wanted)
+                throw std::runtime_error("No such edge");
+            removed[order[pos++]] = true;
+        }
+        return removed;
+    }
+
+    // removes the edges of lists given by the removals, all or none of them
+    static void remove_from(std::vector<std::vector<WeightedEdge>>& lists,
+                            std::vector<std::tuple<int, int, int>>& removals) {
+        std::sort(removals.begin(), removals.end());
+        std::vector<std::pair<int, std::vector<char>>> removed_by_node;
+        for (auto first = removals.begin(); first != removals.end();) {
+            int node = std::get<0>(*first);
+            auto last = std::find_if(first, removals.end(), [&](auto const& removal) { return std::get<0>(removal) != node; });
+            removed_by_node.emplace_back(node, find_removed(lists[node], first, last));
+            first = last;
+        }
+
+        for (auto const& node_removed: removed_by_node) {
+            std::vector<WeightedEdge>& list = lists[node_removed.first];
+            size_t kept = 0;
+            for (size_t idx = 0; idx < list.size(); idx++)
+                if (!node_removed.second[idx])
+                    list[kept++] = list[idx];
+            list.resize(kept);
+        }
+    }
+
+    void check_node(int node) const {
+        if (node < 0 || node >= nodeCount())
+            throw std::runtime_error("No such node");
+    }
+
+public:
+    Graph() {}
+
+    explicit Graph(int node_count) : edge_list(node_count), reverse_edge_list(node_count) {}
+
+    int nodeCount() const { return edge_list.size(); }
+
+    std::vector<WeightedEdge> const& edges(int from) const { return edge_list[from]; }
+
+    std::vector<WeightedEdge> const& reverse_edges(int to) const { return reverse_edge_list[to]; }
+
+    // appends a batch of edges (parallel edges and loops are fine, just as in the input)
+    void add_edges(std::vector<WeightedEdge> const& edges) {
+        for (WeightedEdge const& edge: edges) {
+            check_node(edge.from);
+            check_node(edge.to);
+        }
+        for (WeightedEdge const& edge: edges) {
+            edge_list[edge.from].emplace_back(edge.from, edge.to, edge.weight);
+            reverse_edge_list[edge.to].emplace_back(edge.to, edge.from, edge.weight);
+        }
+    }
+
+    // removes a batch of edges, one for each given (so removing a parallel edge twice removes two of them);
+    // the order of the remaining edges is kept, and nothing is removed if any of them is missing
+    void remove_edges(std::vector<WeightedEdge> const& edges) {
+        std::vector<std::tuple<int, int, int>> removals, reverse_removals;
+        for (WeightedEdge const& edge: edges) {
+            check_node(edge.from);
+            check_node(edge.to);
+            removals.emplace_back(edge.from, edge.to, edge.weight);
+            reverse_removals.emplace_back(edge.to, edge.from, edge.weight);
+        }
+        remove_from(edge_list, removals);
+        remove_from(reverse_edge_list, reverse_removals); // can't fail once the forward edges were all found
+    }
+
+    friend std::istream& operator>>(std::istream& is, Graph& g);
+};
+
+inline std::istream& operator>>(std::istream& is, Graph& g) {
+    int node_count;
+    is >> node_count;
+    g.edge_list.resize(node_count);
+    g.reverse_edge_list.resize(node_count);
+    for (int from = 0; from < node_count; from++) {
+        int edge_count;
+        is >> edge_count;
+        for (int count = 0; count < edge_count; count++) {
+            int to, weight;
+            is >> to >> weight;
+            g.edge_list[from].emplace_back(from, to, weight);
+            g.reverse_edge_list[to].emplace_back(to, from, weight);
+        }
+    }
+    return is;
+}
+
+#endif //PLAYGROUND_GRAPH_HPP
@@ -0,0 +1,688 @@
+#ifndef PLAYGROUND_GRAPHALGORITHMS_HPP
+#define PLAYGROUND_GRAPHALGORITHMS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <climits>
+#include <deque>
+#include <stdexcept>
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+#include "../algo_and_ds/IndexedHeap.hpp"
+#include "../algo_and_ds/RadixHeap.hpp"
+
+// Every algorithm is written against the interface of Graph (nodeCount(), edges(), reverse_edges()),
+// so they run on any representation that provides it, e.g. CsrGraph.
+
+template<typename G = Graph>
+class DfsInfo {
+public:
+    // Whether the classified edges are copied, or only their indices are recorded.
+    // The index of an edge is its position in the concatenation of all the edge lists.
+    enum class Recording { EDGES, EDGE_INDICES };
+
+private:
+    struct Frame {
+        int node;
+        size_t cursor; // the next edge of node to look at
+    };
+
+    G const& graph;
+    Recording recording;
+    int current_depth;
+    int current_end;
+    std::vector<int> depth_nums;
+    std::vector<int> end_nums;
+    std::vector<size_t> edge_offsets;
+    std::vector<Frame> frames;
+    std::vector<WeightedEdge> tree_edges;
+    std::vector<WeightedEdge> loop_edges;
+    std::vector<WeightedEdge> forward_edges;
+    std::vector<WeightedEdge> back_edges;
+    std::vector<WeightedEdge> cross_edges;
+    std::vector<size_t> tree_edge_indices;
+    std::vector<size_t> loop_edge_indices;
+    std::vector<size_t> forward_edge_indices;
+    std::vector<size_t> back_edge_indices;
+    std::vector<size_t> cross_edge_indices;
+
+    DfsInfo(G const& graph, Recording recording) : graph(graph), recording(recording), current_depth(0), current_end(0),
+                                                   depth_nums(graph.nodeCount(), INT_MAX), end_nums(graph.nodeCount(), INT_MAX),
+                                                   tree_edges(), loop_edges(), forward_edges(), back_edges(), cross_edges() {
+        // here we initialized everything we will want to make use of in DFS
+        frames.reserve(graph.nodeCount());
+        if (recording == Recording::EDGE_INDICES) {
+            edge_offsets.resize(graph.nodeCount() + 1, 0);
+            for (int node = 0; node < graph.nodeCount(); node++)
+                edge_offsets[node + 1] = edge_offsets[node] + graph.edges(node).size();
+        }
+    }
+
+    void record(std::vector<WeightedEdge>& edges, std::vector<size_t>& indices, WeightedEdge const& edge,
+                Frame const& frame) {
+        if (recording == Recording::EDGES)
+            edges.push_back(edge);
+        else
+            indices.push_back(edge_offsets[frame.node] + frame.cursor);
+    }
+
+    // The recursion is unrolled onto an explicit stack of frames, so that deep graphs
+    // (e.g. long chains) can't overflow the call stack. Every node is on the stack at
+    // most once, hence it never needs to grow beyond the preallocated node count.
+    void dfs(int start) {
+        depth_nums[start] = ++current_depth;
+        frames.push_back(Frame{start, 0});
+
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            auto const& edges = graph.edges(frame.node);
+            if (frame.cursor == edges.size()) {
+                end_nums[frame.node] = ++current_end;
+                frames.pop_back();
+                continue;
+            }
+
+            WeightedEdge edge = edges[frame.cursor];
+            if (depth_nums[edge.to] == INT_MAX) {
+                record(tree_edges, tree_edge_indices, edge, frame);
+                frame.cursor++;
+                depth_nums[edge.to] = ++current_depth;
+                frames.push_back(Frame{edge.to, 0});
+                continue;
+            } else if (edge.to == frame.node) {
+                record(loop_edges, loop_edge_indices, edge, frame);
+            } else if (depth_nums[edge.to] > depth_nums[frame.node]) {
+                record(forward_edges, forward_edge_indices, edge, frame);
+            } else if (end_nums[edge.to] == INT_MAX) {
+                record(back_edges, back_edge_indices, edge, frame);
+            } else {
+                record(cross_edges, cross_edge_indices, edge, frame);
+            }
+            frame.cursor++;
+        }
+    }
+
+    void printEdges(std::vector<WeightedEdge> const& edges, std::vector<size_t> const& indices, std::ostream& os) const {
+        for (WeightedEdge const& edge: edges)
+            os << '\t' << edge.from << " -> " << edge.to << " (" << edge.weight << ") " << std::endl;
+        for (size_t index: indices) {
+            WeightedEdge edge = edgeAt(index);
+            os << '\t' << edge.from << " -> " << edge.to << " (" << edge.weight << ") " << std::endl;
+        }
+    }
+
+public:
+    void printResults(std::ostream& os = std::cout) const {
+        os << "Total node count: " << graph.nodeCount() << std::endl;
+        for (int node = 0; node < graph.nodeCount(); node++)
+            os << "Node " << node << " started " << depth_nums[node] << ", ended " << end_nums[node] << std::endl;
+        os << "One possible classification of the edges in the graph:" << std::endl;
+        os << " - Tree edges:" << std::endl;
+        printEdges(tree_edges, tree_edge_indices, os);
+        os << " - Loop edges:" << std::endl;
+        printEdges(loop_edges, loop_edge_indices, os);
+        os << " - Forward edges:" << std::endl;
+        printEdges(forward_edges, forward_edge_indices, os);
+        os << " - Back edges:" << std::endl;
+        printEdges(back_edges, back_edge_indices, os);
+        os << " - Cross edges:" << std::endl;
+        printEdges(cross_edges, cross_edge_indices, os);
+    }
+
+    std::vector<int> const& getDepthNums() const { return depth_nums; }
+
+    std::vector<int> const& getEndNums() const { return end_nums; }
+
+    std::vector<WeightedEdge> const& getTreeEdges() const { return tree_edges; }
+
+    std::vector<WeightedEdge> const& getLoopEdges() const { return loop_edges; }
+
+    std::vector<WeightedEdge> const& getForwardEdges() const { return forward_edges; }
+
+    std::vector<WeightedEdge> const& getBackEdges() const { return back_edges; }
+
+    std::vector<WeightedEdge> const& getCrossEdges() const { return cross_edges; }
+
+    std::vector<size_t> const& getTreeEdgeIndices() const { return tree_edge_indices; }
+
+    std::vector<size_t> const& getLoopEdgeIndices() const { return loop_edge_indices; }
+
+    std::vector<size_t> const& getForwardEdgeIndices() const { return forward_edge_indices; }
+
+    std::vector<size_t> const& getBackEdgeIndices() const { return back_edge_indices; }
+
+    std::vector<size_t> const& getCrossEdgeIndices() const { return cross_edge_indices; }
+
+    // looks up an edge by its index (only available when recording edge indices)
+    WeightedEdge edgeAt(size_t index) const {
+        int from = std::upper_bound(edge_offsets.begin(), edge_offsets.end(), index) - edge_offsets.begin() - 1;
+        return graph.edges(from)[index - edge_offsets[from]];
+    }
+
+    static DfsInfo dfs(G const& graph, int start, Recording recording = Recording::EDGES) {
+        DfsInfo di(graph, recording);
+        di.dfs(start);
+        return di;
+    }
+
+    static DfsInfo dfs(G const& graph, Recording recording = Recording::EDGES) {
+        DfsInfo di(graph, recording);
+
+        for (int node = 0; node < graph.nodeCount(); node++)
+            if (di.depth_nums[node] == INT_MAX)
+                di.dfs(node);
+
+        return di;
+    }
+};
+
+template<typename G>
+std::vector<int> topological_sort(G const& graph) {
+    // only the presence of loop or back edges matters, there's no need to copy any of them
+    DfsInfo<G> dfs = DfsInfo<G>::dfs(graph, DfsInfo<G>::Recording::EDGE_INDICES);
+
+    if (!dfs.getLoopEdgeIndices().empty() || !dfs.getBackEdgeIndices().empty())
+        throw std::runtime_error("Graph is not a DAG.");
+
+    std::vector<int> ts(graph.nodeCount());
+    for (int node = 0; node < graph.nodeCount(); node++)
+        ts[graph.nodeCount() - dfs.getEndNums()[node]] = node;
+
+    return ts;
+}
+
+template<typename G>
+std::vector<int> shortest_distance_from_s(G const& graph, int s) {
+    std::vector<int> ts = topological_sort(graph);
+    std::vector<int> distances(graph.nodeCount());
+
+    int v_idx;
+    // fill up nodes that are unreachable from s with infinity
+    for (v_idx = 0; ts[v_idx] != s; v_idx++)
+        distances[ts[v_idx]] = INT_MAX;
+    // s has a distance of 0 from itself
+    distances[ts[v_idx]] = 0;
+    // for every other node, apply the DP method
+    for (v_idx++; v_idx < graph.nodeCount(); v_idx++) {
+        int v = ts[v_idx];
+
+        int min_distance = INT_MAX;
+        for (WeightedEdge const& rev_edge: graph.reverse_edges(v)) {
+            if (distances[rev_edge.to] != INT_MAX) {
+                // if the preceding node does not have a distance of infinity from s
+                int distance = distances[rev_edge.to] + rev_edge.weight;
+                if (distance < min_distance)
+                    min_distance = distance;
+            }
+        }
+
+        distances[v] = min_distance;
+    }
+
+    return distances;
+}
+
+// Kahn's algorithm, level by level: a level holds the nodes whose predecessors are all in
+// the preceding levels, so the nodes of a level don't depend on each other at all. The
+// in-degrees are counted down atomically, so a level can be expanded in parallel.
+template<typename G>
+std::vector<std::vector<int>> topological_levels(G const& graph, ThreadPool& pool) {
+    int node_count = graph.nodeCount();
+    std::vector<std::atomic<int>> in_degrees(node_count);
+    std::vector<std::vector<int>> found(pool.size());
+    pool.parallel_for(0, node_count, [&](size_t node, size_t worker) {
+        in_degrees[node].store(graph.reverse_edges(node).size(), std::memory_order_relaxed);
+        if (graph.reverse_edges(node).size() == 0)
+            found[worker].push_back(node);
+    }, 1024);
+
+    std::vector<std::vector<int>> levels;
+    size_t level_node_count = 0;
+    while (true) {
+        std::vector<int> level;
+        for (std::vector<int>& nodes: found) {
+            level.insert(level.end(), nodes.begin(), nodes.end());
+            nodes.clear();
+        }
+        if (level.empty())
+            break;
+        std::sort(level.begin(), level.end()); // so that the result doesn't depend on the scheduling
+        level_node_count += level.size();
+        levels.push_back(std::move(level));
+
+        std::vector<int> const& frontier = levels.back();
+        pool.parallel_for(0, frontier.size(), [&](size_t idx, size_t worker) {
+            for (WeightedEdge const& edge: graph.edges(frontier[idx]))
+                if (in_degrees[edge.to].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    found[worker].push_back(edge.to);
+        }, 64);
+    }
+
+    if (level_node_count != static_cast<size_t>(node_count))
+        throw std::runtime_error("Graph is not a DAG.");
+
+    return levels;
+}
+
+template<typename G>
+std::vector<int> topological_sort(G const& graph, ThreadPool& pool) {
+    std::vector<int> ts;
+    ts.reserve(graph.nodeCount());
+    for (std::vector<int> const& level: topological_levels(graph, pool))
+        ts.insert(ts.end(), level.begin(), level.end());
+    return ts;
+}
+
+// The same DP as above, but the nodes of a level are computed in parallel. Every node
+// pulls its distance from its predecessors, which are all in earlier levels, so no
+// two workers ever write the same distance.
+template<typename G>
+std::vector<int> shortest_distance_from_s(G const& graph, int s, ThreadPool& pool) {
+    std::vector<std::vector<int>> levels = topological_levels(graph, pool);
+    std::vector<int> distances(graph.nodeCount(), INT_MAX);
+
+    size_t level_idx = 0;
+    // the levels before that of s are unreachable from s
+    while (!std::binary_search(levels[level_idx].begin(), levels[level_idx].end(), s))
+        level_idx++;
+    // s has a distance of 0 from itself
+    distances[s] = 0;
+    // the rest of its level is unreachable from s as well, for every other node apply the DP method
+    for (level_idx++; level_idx < levels.size(); level_idx++) {
+        std::vector<int> const& level = levels[level_idx];
+        pool.parallel_for(0, level.size(), [&](size_t idx, size_t) {
+            int v = level[idx];
+
+            int min_distance = INT_MAX;
+            for (WeightedEdge const& rev_edge: graph.reverse_edges(v)) {
+                if (distances[rev_edge.to] != INT_MAX) {
+                    // if the preceding node does not have a distance of infinity from s
+                    int distance = distances[rev_edge.to] + rev_edge.weight;
+                    if (distance < min_distance)
+                        min_distance = distance;
+                }
+            }
+
+            distances[v] = min_distance;
+        }, 256);
+    }
+
+    return distances;
+}
+
+template<typename G = Graph>
+class BfsInfo {
+private:
+    G const& graph;
+    int current_visit;
+    std::deque<int> next_to_visit;
+    std::vector<int> visits;
+    std::vector<int> distances;
+
+    explicit BfsInfo(G const& graph) : graph(graph), current_visit(0), next_to_visit(),
+                                           visits(graph.nodeCount(), INT_MAX), distances(graph.nodeCount(), INT_MAX) {
+        // here we initialized everything we will want to make use of in BFS
+    }
+
+    void bfs(int s) {
+        visits[s] = ++current_visit;
+        distances[s] = 0;
+        next_to_visit.push_back(s);
+        do {
+            int node = next_to_visit.front();
+            next_to_visit.pop_front();
+
+            for (Edge const& edge: graph.edges(node)) {
+                if (visits[edge.to] == INT_MAX) {
+                    visits[edge.to] = ++current_visit;
+                    distances[edge.to] = distances[edge.from] + 1;
+                    next_to_visit.emplace_back(edge.to);
+                }
+            }
+        } while (!next_to_visit.empty());
+    }
+
+    // Direction-optimizing BFS (Beamer et al.), one level at a time. A level is either
+    // expanded top-down (the frontier claims its unvisited neighbours) or, when the
+    // frontier has become large, bottom-up (every unvisited node looks for a parent in
+    // the frontier through its reverse edges).
+    //
+    // The new level is then put in the order the sequential BFS would visit it, sorted by
+    // the key of each node: the visit number of its earliest visited parent and the index
+    // of the first edge of that parent leading to it. The keys are found while expanding,
+    // so no level is scanned twice:
+    //  - top-down, every frontier edge into the new level lowers the key of its target,
+    //  - bottom-up, a node that has found a parent scans the rest of its reverse edges too,
+    //    for the earliest visited one (so only the reverse edges of the new level lose the
+    //    early exit). The edge indices are only needed to order the nodes sharing a parent,
+    //    so only the parents that have adopted more than one node scan their edges for them.
+    void bfs_parallel(int s, ThreadPool& pool) {
+        static const int alpha = 14;
+        static const int beta = 24;
+        const uint64_t no_key = UINT64_MAX;
+        const uint64_t no_edge = UINT32_MAX; // the low half of a key whose edge index isn't known
+
+        size_t node_count = graph.nodeCount();
+        size_t word_count = (node_count + 63) / 64;
+        std::vector<std::atomic<int>> levels(node_count);
+        std::vector<std::atomic<uint64_t>> keys(node_count);
+        std::vector<int> parents(node_count); // the ones found bottom-up
+        pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+            levels[node].store(INT_MAX, std::memory_order_relaxed);
+            keys[node].store(no_key, std::memory_order_relaxed);
+        }, 4096);
+
+        std::vector<uint64_t> frontier_bits(word_count, 0);
+        std::vector<uint64_t> visited_bits(word_count, 0);
+        std::vector<std::vector<int>> found(pool.size());
+        std::vector<int> frontier, next;
+
+        long long unexplored_edges = 0;
+        for (size_t node = 0; node < node_count; node++)
+            unexplored_edges += graph.edges(node).size();
+
+        levels[s].store(0, std::memory_order_relaxed);
+        visited_bits[s / 64] |= uint64_t(1) << (s % 64);
+        visits[s] = ++current_visit;
+        distances[s] = 0;
+        frontier.push_back(s);
+        unexplored_edges -= graph.edges(s).size();
+
+        bool bottom_up = false;
+        for (int level = 0; !frontier.empty(); level++) {
+            long long frontier_edges = 0;
+            for (int node: frontier)
+                frontier_edges += graph.edges(node).size();
+
+            if (!bottom_up && frontier_edges > unexplored_edges / alpha)
+                bottom_up = true;
+            else if (bottom_up && frontier.size() < node_count / beta)
+                bottom_up = false;
+
+            if (bottom_up) {
+                for (int node: frontier)
+                    frontier_bits[node / 64] |= uint64_t(1) << (node % 64);
+
+                // every worker owns whole words, so no two of them touch the same bits
+                pool.parallel_for(0, word_count, [&](size_t word, size_t worker) {
+                    if (visited_bits[word] == UINT64_MAX)
+                        return;
+                    for (size_t node = word * 64; node < node_count && node < (word + 1) * 64; node++) {
+                        if (visited_bits[word] & (uint64_t(1) << (node % 64)))
+                            continue;
+                        int parent = -1;
+                        for (Edge const& rev_edge: graph.reverse_edges(node)) {
+                            int candidate = rev_edge.to;
+                            if ((frontier_bits[candidate / 64] & (uint64_t(1) << (candidate % 64))) &&
+                                (parent == -1 || visits[candidate] < visits[parent]))
+                                parent = candidate;
+                        }
+                        if (parent != -1) {
+                            levels[node].store(level + 1, std::memory_order_relaxed);
+                            keys[node].store((uint64_t(visits[parent]) << 32) | no_edge, std::memory_order_relaxed);
+                            parents[node] = parent;
+                            found[worker].push_back(node);
+                        }
+                    }
+                }, 16);
+
+                for (int node: frontier)
+                    frontier_bits[node / 64] = 0;
+            } else {
+                pool.parallel_for(0, frontier.size(), [&](size_t idx, size_t worker) {
+                    int node = frontier[idx];
+                    uint64_t edge_idx = 0;
+                    for (Edge const& edge: graph.edges(node)) {
+                        int unvisited = INT_MAX;
+                        if (levels[edge.to].load(std::memory_order_relaxed) == INT_MAX &&
+                            levels[edge.to].compare_exchange_strong(unvisited, level + 1, std::memory_order_relaxed))
+                            found[worker].push_back(edge.to);
+                        // whoever claimed it, it's in the new level
+                        if (levels[edge.to].load(std::memory_order_relaxed) == level + 1) {
+                            uint64_t key = (uint64_t(visits[node]) << 32) | edge_idx;
+                            uint64_t current = keys[edge.to].load(std::memory_order_relaxed);
+                            while (key < current && !keys[edge.to].compare_exchange_weak(current, key, std::memory_order_relaxed));
+                        }
+                        edge_idx++;
+                    }
+                }, 64);
+            }
+
+            next.clear();
+            for (std::vector<int>& nodes: found) {
+                next.insert(next.end(), nodes.begin(), nodes.end());
+                nodes.clear();
+            }
+
+            auto by_key = [&](int lhs, int rhs) {
+                return keys[lhs].load(std::memory_order_relaxed) < keys[rhs].load(std::memory_order_relaxed);
+            };
+            std::sort(next.begin(), next.end(), by_key);
+
+            if (bottom_up) {
+                // the runs of nodes sharing a parent are ordered by the first edge of the parent leading to each
+                std::vector<std::pair<size_t, size_t>> siblings;
+                for (size_t first = 0, last; first < next.size(); first = last) {
+                    for (last = first + 1; last < next.size() && parents[next[last]] == parents[next[first]]; last++);
+                    if (last - first > 1)
+                        siblings.emplace_back(first, last);
+                }
+                pool.parallel_for(0, siblings.size(), [&](size_t idx, size_t) {
+                    int parent = parents[next[siblings[idx].first]];
+                    uint64_t edge_idx = 0;
+                    for (Edge const& edge: graph.edges(parent)) {
+                        uint64_t key = keys[edge.to].load(std::memory_order_relaxed);
+                        if (levels[edge.to].load(std::memory_order_relaxed) == level + 1 &&
+                            parents[edge.to] == parent && (key & no_edge) == no_edge)
+                            keys[edge.to].store(key - no_edge + edge_idx, std::memory_order_relaxed);
+                        edge_idx++;
+                    }
+                    std::sort(next.begin() + siblings[idx].first, next.begin() + siblings[idx].second, by_key);
+                }, 1);
+            }
+
+            for (int node: next) {
+                visited_bits[node / 64] |= uint64_t(1) << (node % 64);
+                visits[node] = ++current_visit;
+                distances[node] = level + 1;
+                unexplored_edges -= graph.edges(node).size();
+            }
+            frontier.swap(next);
+        }
+    }
+
+public:
+    void printResults(std::ostream& os = std::cout) const {
+        os << "Total node count: " << graph.nodeCount() << std::endl;
+        for (int node = 0; node < graph.nodeCount(); node++) {
+            os << "\t[ node " << node << " ]";
+            if (visits[node] == INT_MAX)
+                os << " was never reached";
+            else
+                os << " was #" << visits[node] << " with a distance of " << distances[node];
+            os << std::endl;
+        }
+    }
+
+    std::vector<int> const& getVisits() const { return visits; }
+
+    std::vector<int> const& getDistances() const { return distances; }
+
+    static BfsInfo bfs(G const& graph, int start) {
+        BfsInfo bfs_info(graph);
+        bfs_info.bfs(start);
+        return bfs_info;
+    }
+
+    static BfsInfo bfs_parallel(G const& graph, int start, ThreadPool& pool) {
+        BfsInfo bfs_info(graph);
+        bfs_info.bfs_parallel(start, pool);
+        return bfs_info;
+    }
+};
+
+template<typename G = Graph>
+class DijkstraInfo {
+private:
+    G const& graph;
+    std::vector<int> current_bests;
+    std::vector<int> distances;
+
+    explicit DijkstraInfo(G const& graph) : graph(graph), current_bests(graph.nodeCount(), INT_MAX),
+                                                distances(graph.nodeCount(), INT_MAX) {
+        // here we initialized everything we will want to make use of in BFS
+    }
+
+    int min() const {
+        int min_node;
+
+        for (min_node = 0; min_node < graph.nodeCount() &&
+                           (current_bests[min_node] == INT_MIN || current_bests[min_node] == INT_MAX); min_node++);
+
+        for (int node = min_node + 1; node < graph.nodeCount(); node++)
+            if (current_bests[node] != INT_MIN && current_bests[node] != INT_MAX &&
+                current_bests[node] < current_bests[min_node])
+                min_node = node;
+
+        return min_node;
+    }
+
+    void dijkstra(int start) {
+        distances[start] = 0;
+        for (WeightedEdge const& edge: graph.edges(start))
+            if (0 + edge.weight < current_bests[edge.to]) // there may be parallel edges
+                current_bests[edge.to] = 0 + edge.weight;
+        current_bests[start] = INT_MIN;
+
+        int node;
+        while ((node = min()) != graph.nodeCount()) {
+            distances[node] = current_bests[node];
+            current_bests[node] = INT_MIN;
+
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                int distance = distances[node] + edge.weight;
+                if (distance < current_bests[edge.to])
+                    current_bests[edge.to] = distance;
+            }
+        }
+    }
+
+    // Instead of scanning for the minimum, the candidates are kept in an indexed heap,
+    // so an improved candidate is moved up in place (decrease-key) rather than pushed
+    // again, and the heap never holds more than one entry per node.
+    void dijkstra_heap(int start) {
+        MinIndexedHeap<int> next_nodes(graph.nodeCount()); // keyed by node, prioritized by distance
+
+        current_bests[start] = 0;
+        next_nodes.insert(start, 0);
+        while (!next_nodes.empty()) {
+            int node = next_nodes.extreme_key();
+            distances[node] = next_nodes.extreme();
+            next_nodes.extreme_remove();
+
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                int distance = distances[node] + edge.weight;
+                if (distance < current_bests[edge.to]) {
+                    current_bests[edge.to] = distance;
+                    next_nodes.update(edge.to, distance);
+                }
+            }
+        }
+    }
+
+    // The extracted distances never decrease and the weights are non-negative integers,
+    // so a radix heap can stand in for the comparison-based one. It has no decrease-key,
+    // thus an improved candidate is pushed again and stale entries are skipped.
+    void dijkstra_radix(int start) {
+        RadixHeap<int> next_nodes; // nodes keyed by their tentative distance
+
+        current_bests[start] = 0;
+        next_nodes.insert(0, start);
+        while (!next_nodes.empty()) {
+            unsigned distance_to_node = next_nodes.extreme_key();
+            int node = next_nodes.extreme();
+            next_nodes.extreme_remove();
+
+            if (distances[node] != INT_MAX) // already settled, this is a stale entry
+                continue;
+            distances[node] = distance_to_node;
+
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                int distance = distances[node] + edge.weight;
+                if (distance < current_bests[edge.to]) {
+                    current_bests[edge.to] = distance;
+                    next_nodes.insert(distance, edge.to);
+                }
+            }
+        }
+    }
+
+public:
+    std::vector<int> const& getDistances() const { return distances; }
+
+    static DijkstraInfo dijkstra(G const& graph, int start) {
+        DijkstraInfo dijkstraInfo(graph);
+        dijkstraInfo.dijkstra(start);
+        return dijkstraInfo;
+    }
+
+    static DijkstraInfo dijkstra_heap(G const& graph, int start) {
+        DijkstraInfo dijkstraInfo(graph);
+        dijkstraInfo.dijkstra_heap(start);
+        return dijkstraInfo;
+    }
+
+    static DijkstraInfo dijkstra_radix(G const& graph, int start) {
+        DijkstraInfo dijkstraInfo(graph);
+        dijkstraInfo.dijkstra_radix(start);
+        return dijkstraInfo;
+    }
+};
+
+template<typename G = Graph>
+class PrimInfo {
+private:
+    G const& graph;
+    std::vector<bool> covered;
+    std::vector<WeightedEdge> tree_edges;
+    std::vector<WeightedEdge> best_edges;   // the cheapest known edge leading into each uncovered node
+    MinIndexedHeap<int> next_nodes;         // uncovered nodes prioritized by the weight of their best edge
+
+    explicit PrimInfo(G const& graph) : graph(graph), covered(graph.nodeCount()), best_edges(graph.nodeCount()),
+                                        next_nodes(graph.nodeCount()) {}
+
+public:
+    std::vector<WeightedEdge> const& getTreeEdges() const { return tree_edges; }
+
+    void prim(int s) {
+        covered[s] = true;
+        while (tree_edges.size() + 1 < static_cast<size_t>(graph.nodeCount())) {
+            for (WeightedEdge const& edge: graph.edges(s)) {
+                if (!covered[edge.to] && (!next_nodes.contains(edge.to) || edge.weight < next_nodes.priority(edge.to))) {
+                    best_edges[edge.to] = edge;
+                    next_nodes.update(edge.to, edge.weight);
+                }
+            }
+
+            if (next_nodes.empty())
+                throw std::runtime_error("Graph isn't connected");
+
+            s = next_nodes.extreme_key();
+            next_nodes.extreme_remove();
+
+            tree_edges.push_back(best_edges[s]);
+            covered[s] = true;
+        }
+    }
+
+    static PrimInfo prim(G const& graph, int start) {
+        PrimInfo primInfo(graph);
+        primInfo.prim(start);
+        return primInfo;
+    }
+};
+
+#endif //PLAYGROUND_GRAPHALGORITHMS_HPP
@@ -0,0 +1,171 @@
+#ifndef PLAYGROUND_MULTISOURCEBFS_HPP
+#define PLAYGROUND_MULTISOURCEBFS_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+// Hop distances from many sources at once, the way BfsInfo::bfs would find them from each.
+//
+// The sources are taken 64 at a time (Then et al.'s MS-BFS): every node has a 64-bit
+// mask of the sources that have seen it, and another of the sources it's on the frontier of.
+// A level pushes the frontier mask of every frontier node along its edges with a single
+// OR, so an edge is read once per level for all 64 BFSs instead of once for each of them.
+// The batches of 64 are spread over the pool. This pays off when the BFSs of a batch
+// overlap, i.e. on small-world graphs where they all reach most of the graph in a few
+// levels; on long, thin graphs (e.g. road networks) plain BFS is just as fast.
+//
+// Recording the distance from every source to every node takes sources x nodes ints;
+// the per-source statistics (e.g. for closeness centrality) only take O(nodes) per worker.
+template<typename G = Graph>
+class MultiSourceBfsInfo {
+public:
+    enum class Recording { DISTANCES, STATISTICS };
+
+    struct Statistics {
+        int reached;            // the number of nodes reachable from the source (itself included)
+        long long distance_sum; // the sum of the distances to them
+        int eccentricity;       // the largest of them
+    };
+
+private:
+    typedef uint64_t Mask;
+    static constexpr size_t batch_size = 64;
+
+    struct Scratch {
+        std::vector<Mask> seen;
+        std::vector<Mask> frontier;
+        std::vector<Mask> next_frontier;
+        std::vector<int> frontier_nodes;      // the nodes with a non-zero frontier mask
+        std::vector<int> next_frontier_nodes; // the nodes with a non-zero next frontier mask
+
+        // allocated by the worker using it, on its first batch; a batch leaves the frontier masks all zero
+        void allocate(int node_count) {
+            if (seen.size() != static_cast<size_t>(node_count)) {
+                seen.assign(node_count, 0);
+                frontier.assign(node_count, 0);
+                next_frontier.assign(node_count, 0);
+            }
+        }
+    };
+
+    G const& graph;
+    std::vector<int> sources;
+    Recording recording;
+    std::vector<std::vector<int>> distances;
+    std::vector<Statistics> statistics;
+
+    MultiSourceBfsInfo(G const& graph, std::vector<int> sources, Recording recording)
+            : graph(graph), sources(std::move(sources)), recording(recording),
+              statistics(this->sources.size(), Statistics{0, 0, 0}) {
+        if (recording == Recording::DISTANCES)
+            distances.assign(this->sources.size(), std::vector<int>(graph.nodeCount(), INT_MAX));
+    }
+
+    // the nodes of newly_reached (by bit) are at distance level from the sources of the batch starting at first
+    void record(size_t first, int node, Mask newly_reached, int level) {
+        while (newly_reached != 0) {
+            size_t bit = count_trailing_zeros(newly_reached);
+            newly_reached &= newly_reached - 1;
+
+            Statistics& source_statistics = statistics[first + bit];
+            source_statistics.reached++;
+            source_statistics.distance_sum += level;
+            source_statistics.eccentricity = level;
+            if (recording == Recording::DISTANCES)
+                distances[first + bit][node] = level;
+        }
+    }
+
+    static size_t count_trailing_zeros(Mask mask) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(mask);
+#else
+        size_t zeros = 0;
+        for (; (mask & 1) == 0; mask >>= 1)
+            zeros++;
+        return zeros;
+#endif
+    }
+
+    void batch(size_t first, Scratch& scratch) {
+        size_t count = std::min(batch_size, sources.size() - first);
+        scratch.allocate(graph.nodeCount());
+        std::fill(scratch.seen.begin(), scratch.seen.end(), 0);
+
+        scratch.frontier_nodes.clear();
+        for (size_t bit = 0; bit < count; bit++) {
+            int source = sources[first + bit];
+            if (scratch.seen[source] == 0)
+                scratch.frontier_nodes.push_back(source);
+            scratch.seen[source] |= Mask(1) << bit;
+            scratch.frontier[source] |= Mask(1) << bit;
+        }
+        for (int node: scratch.frontier_nodes)
+            record(first, node, scratch.frontier[node], 0);
+
+        for (int level = 1; !scratch.frontier_nodes.empty(); level++) {
+            scratch.next_frontier_nodes.clear();
+            for (int node: scratch.frontier_nodes) {
+                Mask frontier = scratch.frontier[node];
+                for (WeightedEdge const& edge: graph.edges(node)) {
+                    if (scratch.next_frontier[edge.to] == 0)
+                        scratch.next_frontier_nodes.push_back(edge.to);
+                    scratch.next_frontier[edge.to] |= frontier;
+                }
+            }
+            for (int node: scratch.frontier_nodes)
+                scratch.frontier[node] = 0;
+
+            scratch.frontier_nodes.clear();
+            for (int node: scratch.next_frontier_nodes) {
+                Mask newly_reached = scratch.next_frontier[node] & ~scratch.seen[node];
+                scratch.next_frontier[node] = 0;
+                if (newly_reached != 0) {
+                    scratch.seen[node] |= newly_reached;
+                    scratch.frontier[node] = newly_reached;
+                    scratch.frontier_nodes.push_back(node);
+                    record(first, node, newly_reached, level);
+                }
+            }
+        }
+    }
+
+    void run(ThreadPool& pool) {
+        std::vector<Scratch> scratches(pool.size());
+        size_t batch_count = (sources.size() + batch_size - 1) / batch_size;
+        pool.parallel_for(0, batch_count, [&](size_t batch_idx, size_t worker) {
+            batch(batch_idx * batch_size, scratches[worker]);
+        }, 1);
+    }
+
+public:
+    std::vector<int> const& getSources() const { return sources; }
+
+    // the distances from each source (in the order of the sources) to every node, INT_MAX if unreachable
+    std::vector<std::vector<int>> const& getDistances() const { return distances; }
+
+    std::vector<Statistics> const& getStatistics() const { return statistics; }
+
+    static MultiSourceBfsInfo bfs(G const& graph, std::vector<int> sources, ThreadPool& pool,
+                                  Recording recording = Recording::DISTANCES) {
+        MultiSourceBfsInfo msbfs_info(graph, std::move(sources), recording);
+        msbfs_info.run(pool);
+        return msbfs_info;
+    }
+
+    // from every node of the graph
+    static MultiSourceBfsInfo all_pairs(G const& graph, ThreadPool& pool, Recording recording = Recording::DISTANCES) {
+        std::vector<int> sources(graph.nodeCount());
+        for (int node = 0; node < graph.nodeCount(); node++)
+            sources[node] = node;
+        return bfs(graph, std::move(sources), pool, recording);
+    }
+};
+
+#endif //PLAYGROUND_MULTISOURCEBFS_HPP
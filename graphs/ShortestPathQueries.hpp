@@ -0,0 +1,199 @@
+#ifndef PLAYGROUND_SHORTESTPATHQUERIES_HPP
+#define PLAYGROUND_SHORTESTPATHQUERIES_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+#include "../algo_and_ds/IndexedHeap.hpp"
+
+// The state of one Dijkstra search, allocated once and reused by query after query.
+// Instead of resetting the distances to infinity before every query, each distance is
+// stamped with the generation (the query counter) it was written in, and a stale stamp
+// reads as infinity, so starting a query costs O(1) rather than O(V).
+struct DijkstraScratch {
+    std::vector<int> distances;
+    std::vector<unsigned> generations;
+    unsigned generation;
+    MinIndexedHeap<int> next_nodes;
+
+    explicit DijkstraScratch(int node_count) : distances(node_count), generations(node_count, 0), generation(0),
+                                                next_nodes(node_count) {}
+
+    void next_query() {
+        if (++generation == 0) { // wrapped around, the old stamps could be mistaken for fresh ones
+            std::fill(generations.begin(), generations.end(), 0);
+            generation = 1;
+        }
+        next_nodes.clear();
+    }
+
+    int distance(int node) const { return generations[node] == generation ? distances[node] : INT_MAX; }
+
+    void set_distance(int node, int distance) {
+        generations[node] = generation;
+        distances[node] = distance;
+    }
+};
+
+// Answers many Dijkstra queries against the same graph, spread over a thread pool.
+//
+// Every worker owns a DijkstraScratch sized to the graph, so queries allocate nothing.
+// Point-to-point queries stop as soon as the target is settled.
+//
+// Single point-to-point queries can also be answered by a bidirectional search (growing
+// a forward search from the source and a backward one from the target over the reverse
+// edges, until they meet in the middle) or by A*, guided towards the target by a lower
+// bound on the remaining distance. Both settle a fraction of the nodes plain Dijkstra does.
+//
+// An engine must not be used from several threads at once: batch the queries instead.
+template<typename G = Graph>
+class ShortestPathQueryEngine {
+private:
+    G const& graph;
+    ThreadPool& pool;
+    std::vector<DijkstraScratch> scratches;
+    DijkstraScratch backward_scratch;
+
+    // runs Dijkstra from source until target is settled (or until the end, if target is -1)
+    int dijkstra(DijkstraScratch& scratch, int source, int target) const {
+        scratch.next_query();
+        scratch.set_distance(source, 0);
+        scratch.next_nodes.insert(source, 0);
+
+        while (!scratch.next_nodes.empty()) {
+            int node = scratch.next_nodes.extreme_key();
+            scratch.next_nodes.extreme_remove();
+            if (node == target)
+                break;
+
+            int distance_to_node = scratch.distance(node);
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                int distance = distance_to_node + edge.weight;
+                if (distance < scratch.distance(edge.to)) {
+                    scratch.set_distance(edge.to, distance);
+                    scratch.next_nodes.update(edge.to, distance);
+                }
+            }
+        }
+
+        return target == -1 ? 0 : scratch.distance(target);
+    }
+
+public:
+    ShortestPathQueryEngine(G const& graph, ThreadPool& pool)
+            : graph(graph), pool(pool), scratches(pool.size(), DijkstraScratch(graph.nodeCount())),
+              backward_scratch(graph.nodeCount()) {}
+
+    // a single point-to-point query, on the calling thread
+    int distance(int source, int target) { return dijkstra(scratches[0], source, target); }
+
+    // the same as distance(), searching from both ends at once, on the calling thread
+    int bidirectional_distance(int source, int target) {
+        if (source == target)
+            return 0;
+
+        DijkstraScratch& forward = scratches[0];
+        DijkstraScratch& backward = backward_scratch;
+        forward.next_query();
+        backward.next_query();
+        forward.set_distance(source, 0);
+        forward.next_nodes.insert(source, 0);
+        backward.set_distance(target, 0);
+        backward.next_nodes.insert(target, 0);
+
+        int best = INT_MAX; // the shortest path through a node reached from both sides so far
+        while (!forward.next_nodes.empty() && !backward.next_nodes.empty()) {
+            int forward_min = forward.next_nodes.extreme(), backward_min = backward.next_nodes.extreme();
+            // every path not seen yet is at least as long as the two closest unsettled nodes together
+            if (best != INT_MAX && forward_min + backward_min >= best)
+                break;
+
+            if (forward_min <= backward_min) {
+                int node = forward.next_nodes.extreme_key();
+                forward.next_nodes.extreme_remove();
+                for (WeightedEdge const& edge: graph.edges(node)) {
+                    int distance = forward_min + edge.weight;
+                    if (distance < forward.distance(edge.to)) {
+                        forward.set_distance(edge.to, distance);
+                        forward.next_nodes.update(edge.to, distance);
+                    }
+                    int remaining = backward.distance(edge.to);
+                    if (remaining != INT_MAX)
+                        best = std::min(best, distance + remaining);
+                }
+            } else {
+                int node = backward.next_nodes.extreme_key();
+                backward.next_nodes.extreme_remove();
+                for (WeightedEdge const& rev_edge: graph.reverse_edges(node)) {
+                    int distance = backward_min + rev_edge.weight;
+                    if (distance < backward.distance(rev_edge.to)) {
+                        backward.set_distance(rev_edge.to, distance);
+                        backward.next_nodes.update(rev_edge.to, distance);
+                    }
+                    int remaining = forward.distance(rev_edge.to);
+                    if (remaining != INT_MAX)
+                        best = std::min(best, distance + remaining);
+                }
+            }
+        }
+
+        return best;
+    }
+
+    // the same as distance(), guided by heuristic(node), which must never overestimate the
+    // distance from node to target (nodes are reopened if it isn't consistent, too)
+    template<typename H>
+    int astar_distance(int source, int target, H&& heuristic) {
+        DijkstraScratch& scratch = scratches[0];
+        scratch.next_query();
+        scratch.set_distance(source, 0);
+        scratch.next_nodes.insert(source, heuristic(source));
+
+        while (!scratch.next_nodes.empty()) {
+            int node = scratch.next_nodes.extreme_key();
+            scratch.next_nodes.extreme_remove();
+            if (node == target)
+                break;
+
+            int distance_to_node = scratch.distance(node);
+            for (WeightedEdge const& edge: graph.edges(node)) {
+                int distance = distance_to_node + edge.weight;
+                if (distance < scratch.distance(edge.to)) {
+                    scratch.set_distance(edge.to, distance);
+                    scratch.next_nodes.update(edge.to, distance + heuristic(edge.to));
+                }
+            }
+        }
+
+        return scratch.distance(target);
+    }
+
+    // point-to-point queries given as (source, target) pairs, the answers are in the same order
+    std::vector<int> distances(std::vector<std::pair<int, int>> const& queries) {
+        std::vector<int> answers(queries.size());
+        pool.parallel_for(0, queries.size(), [&](size_t idx, size_t worker) {
+            answers[idx] = dijkstra(scratches[worker], queries[idx].first, queries[idx].second);
+        }, 1);
+        return answers;
+    }
+
+    // the full distance vector of every source (the same as DijkstraInfo::getDistances()),
+    // written into results, whose vectors are reused if they're large enough already
+    void distances_from(std::vector<int> const& sources, std::vector<std::vector<int>>& results) {
+        results.resize(sources.size());
+        pool.parallel_for(0, sources.size(), [&](size_t idx, size_t worker) {
+            DijkstraScratch& scratch = scratches[worker];
+            dijkstra(scratch, sources[idx], -1);
+
+            results[idx].resize(graph.nodeCount());
+            for (int node = 0; node < graph.nodeCount(); node++)
+                results[idx][node] = scratch.distance(node);
+        }, 1);
+    }
+};
+
+#endif //PLAYGROUND_SHORTESTPATHQUERIES_HPP
@@ -0,0 +1,218 @@
+#ifndef PLAYGROUND_SPANNINGFOREST_HPP
+#define PLAYGROUND_SPANNINGFOREST_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+#include "../algo_and_ds/UnionFind.hpp"
+
+// Minimum spanning forests: a minimum spanning tree of every connected component, so
+// unlike PrimInfo, a graph that isn't connected is no error.
+//
+// The edges are taken undirected, an edge from u to v connects v to u just as well.
+// Edges of equal weight are ranked by their position in the graph (the edges of node 0
+// first, in order, then the ones of node 1, and so on), which makes the forest unique:
+// every method finds the very same edges, and returns them in the order of this ranking.
+template<typename G = Graph>
+class SpanningForestInfo {
+private:
+    static constexpr uint64_t no_edge = UINT64_MAX;
+
+    G const& graph;
+    std::vector<WeightedEdge> edge_list; // every edge of the graph, in order
+    std::vector<WeightedEdge> tree_edges;
+
+    explicit SpanningForestInfo(G const& graph) : graph(graph) {}
+
+    // the weight in the high half (flipping the sign bit, so that negative weights come first), the position in the low
+    uint64_t key(uint32_t idx) const {
+        return static_cast<uint64_t>(static_cast<uint32_t>(edge_list[idx].weight) ^ 0x80000000u) << 32 | idx;
+    }
+
+    std::vector<size_t> edge_offsets() const {
+        std::vector<size_t> offsets(graph.nodeCount() + 1, 0);
+        for (int node = 0; node < graph.nodeCount(); node++)
+            offsets[node + 1] = offsets[node] + graph.edges(node).size();
+        if (offsets.back() > UINT32_MAX)
+            throw std::runtime_error("Too many edges for a spanning forest");
+        return offsets;
+    }
+
+    void kruskal() {
+        std::vector<size_t> offsets = edge_offsets();
+        edge_list.reserve(offsets.back());
+        for (int node = 0; node < graph.nodeCount(); node++)
+            for (WeightedEdge const& edge: graph.edges(node))
+                edge_list.push_back(edge);
+
+        std::vector<uint64_t> keys(edge_list.size());
+        for (size_t idx = 0; idx < edge_list.size(); idx++)
+            keys[idx] = key(idx);
+        std::sort(keys.begin(), keys.end());
+
+        UnionFind components(graph.nodeCount());
+        for (uint64_t edge_key: keys) {
+            WeightedEdge const& edge = edge_list[static_cast<uint32_t>(edge_key)];
+            if (components.unite(edge.from, edge.to)) {
+                tree_edges.push_back(edge);
+                if (components.setCount() == 1)
+                    break;
+            }
+        }
+        std::vector<WeightedEdge>().swap(edge_list);
+    }
+
+    // Every round, each component picks the lightest edge leaving it (all in parallel, with an
+    // atomic minimum over the edges), and is hooked onto the component at the other end. As the
+    // edges are ranked strictly, the only cycles this creates are pairs of components picking
+    // the same edge, which are broken up by making the smaller one the root. Then the pointers
+    // are followed to the roots by pointer jumping, the nodes are relabeled, and the edges inside
+    // a component are dropped. The number of components at least halves in every round.
+    void boruvka(ThreadPool& pool) {
+        int node_count = graph.nodeCount();
+        std::vector<size_t> offsets = edge_offsets();
+        edge_list.resize(offsets.back());
+        pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+            auto const& edges = graph.edges(node);
+            for (size_t idx = 0; idx < edges.size(); idx++)
+                edge_list[offsets[node] + idx] = edges[idx];
+        }, 1024);
+
+        std::vector<int> components(node_count); // the root of the component of each node
+        std::vector<int> parents(node_count), next_parents(node_count);
+        std::vector<int> roots(node_count);
+        pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+            components[node] = roots[node] = node;
+        }, 4096);
+
+        std::vector<uint32_t> live_edges(edge_list.size()), next_live_edges;
+        pool.parallel_for(0, edge_list.size(), [&](size_t idx, size_t) {
+            live_edges[idx] = idx;
+        }, 4096);
+
+        std::vector<std::atomic<uint64_t>> lightest(node_count);
+        std::vector<uint32_t> chosen;
+        std::vector<std::vector<uint32_t>> found_edges(pool.size());
+        std::vector<std::vector<int>> found_roots(pool.size());
+
+        while (!live_edges.empty()) {
+            pool.parallel_for(0, roots.size(), [&](size_t idx, size_t) {
+                lightest[roots[idx]].store(no_edge, std::memory_order_relaxed);
+            }, 4096);
+
+            auto lower = [&](int component, uint64_t edge_key) {
+                uint64_t current = lightest[component].load(std::memory_order_relaxed);
+                while (edge_key < current &&
+                       !lightest[component].compare_exchange_weak(current, edge_key, std::memory_order_relaxed));
+            };
+            pool.parallel_for(0, live_edges.size(), [&](size_t idx, size_t) {
+                WeightedEdge const& edge = edge_list[live_edges[idx]];
+                int from = components[edge.from], to = components[edge.to];
+                if (from != to) {
+                    uint64_t edge_key = key(live_edges[idx]);
+                    lower(from, edge_key);
+                    lower(to, edge_key);
+                }
+            }, 4096);
+
+            pool.parallel_for(0, roots.size(), [&](size_t idx, size_t) {
+                int root = roots[idx];
+                uint64_t edge_key = lightest[root].load(std::memory_order_relaxed);
+                if (edge_key == no_edge) {
+                    parents[root] = root;
+                } else {
+                    WeightedEdge const& edge = edge_list[static_cast<uint32_t>(edge_key)];
+                    parents[root] = components[edge.from] == root ? components[edge.to] : components[edge.from];
+                }
+            }, 4096);
+
+            pool.parallel_for(0, roots.size(), [&](size_t idx, size_t worker) {
+                int root = roots[idx], parent = parents[root];
+                if (parent == root || (parents[parent] == root && root < parent)) {
+                    next_parents[root] = root;
+                } else {
+                    next_parents[root] = parent;
+                    found_edges[worker].push_back(static_cast<uint32_t>(lightest[root].load(std::memory_order_relaxed)));
+                }
+            }, 4096);
+
+            size_t chosen_before = chosen.size();
+            for (std::vector<uint32_t>& edges: found_edges) {
+                chosen.insert(chosen.end(), edges.begin(), edges.end());
+                edges.clear();
+            }
+            if (chosen.size() == chosen_before)
+                break; // every component is a connected component of the graph already
+
+            // pointer jumping, until every root points to the root of its tree
+            parents.swap(next_parents);
+            std::atomic<bool> changed(true);
+            while (changed.load(std::memory_order_relaxed)) {
+                changed.store(false, std::memory_order_relaxed);
+                pool.parallel_for(0, roots.size(), [&](size_t idx, size_t) {
+                    int root = roots[idx];
+                    next_parents[root] = parents[parents[root]];
+                    if (next_parents[root] != parents[root])
+                        changed.store(true, std::memory_order_relaxed);
+                }, 4096);
+                parents.swap(next_parents);
+            }
+
+            pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+                components[node] = parents[components[node]];
+            }, 4096);
+
+            pool.parallel_for(0, roots.size(), [&](size_t idx, size_t worker) {
+                if (parents[roots[idx]] == roots[idx])
+                    found_roots[worker].push_back(roots[idx]);
+            }, 4096);
+            roots.clear();
+            for (std::vector<int>& worker_roots: found_roots) {
+                roots.insert(roots.end(), worker_roots.begin(), worker_roots.end());
+                worker_roots.clear();
+            }
+
+            pool.parallel_for(0, live_edges.size(), [&](size_t idx, size_t worker) {
+                WeightedEdge const& edge = edge_list[live_edges[idx]];
+                if (components[edge.from] != components[edge.to])
+                    found_edges[worker].push_back(live_edges[idx]);
+            }, 4096);
+            next_live_edges.clear();
+            for (std::vector<uint32_t>& edges: found_edges) {
+                next_live_edges.insert(next_live_edges.end(), edges.begin(), edges.end());
+                std::vector<uint32_t>().swap(edges);
+            }
+            live_edges.swap(next_live_edges);
+        }
+
+        std::sort(chosen.begin(), chosen.end(), [&](uint32_t a, uint32_t b) { return key(a) < key(b); });
+        tree_edges.reserve(chosen.size());
+        for (uint32_t idx: chosen)
+            tree_edges.push_back(edge_list[idx]);
+        std::vector<WeightedEdge>().swap(edge_list);
+    }
+
+public:
+    std::vector<WeightedEdge> const& getTreeEdges() const { return tree_edges; }
+
+    // Kruskal's algorithm: the edges in order of their weight, skipping the ones closing a cycle
+    static SpanningForestInfo kruskal(G const& graph) {
+        SpanningForestInfo forest_info(graph);
+        forest_info.kruskal();
+        return forest_info;
+    }
+
+    // Borůvka's algorithm, in parallel
+    static SpanningForestInfo boruvka(G const& graph, ThreadPool& pool) {
+        SpanningForestInfo forest_info(graph);
+        forest_info.boruvka(pool);
+        return forest_info;
+    }
+};
+
+#endif //PLAYGROUND_SPANNINGFOREST_HPP
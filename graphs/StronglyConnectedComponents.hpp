@@ -0,0 +1,313 @@
+#ifndef PLAYGROUND_STRONGLYCONNECTEDCOMPONENTS_HPP
+#define PLAYGROUND_STRONGLYCONNECTEDCOMPONENTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+
+// Decomposes a graph into its strongly connected components.
+//
+// The components are numbered by their smallest node, so every method yields the
+// very same ids. The condensation has a node for every component and an edge
+// between two of them if any of their nodes are connected (with the smallest weight
+// among these), so it's a DAG that topological_sort and shortest_distance_from_s
+// can be run on.
+template<typename G = Graph>
+class SccInfo {
+private:
+    G const& graph;
+    std::vector<int> components;
+    int component_count;
+    CsrGraph condensation;
+
+    explicit SccInfo(G const& graph) : graph(graph), components(graph.nodeCount(), -1), component_count(0) {}
+
+    // turns the labels (an arbitrary node of each component) into ids, then builds the condensation
+    void finish(std::vector<int> const& labels) {
+        std::vector<int> ids(graph.nodeCount(), -1);
+        for (int node = 0; node < graph.nodeCount(); node++) {
+            if (ids[labels[node]] == -1)
+                ids[labels[node]] = component_count++;
+            components[node] = ids[labels[node]];
+        }
+
+        std::vector<std::tuple<int, int, int>> links; // (from, to, weight) between components
+        for (int node = 0; node < graph.nodeCount(); node++)
+            for (WeightedEdge const& edge: graph.edges(node))
+                if (components[node] != components[edge.to])
+                    links.emplace_back(components[node], components[edge.to], edge.weight);
+        std::sort(links.begin(), links.end());
+
+        std::vector<size_t> offsets(component_count + 1, 0);
+        std::vector<CsrGraph::Arc> arcs;
+        for (size_t idx = 0; idx < links.size(); idx++) {
+            int from = std::get<0>(links[idx]), to = std::get<1>(links[idx]);
+            if (idx > 0 && std::get<0>(links[idx - 1]) == from && std::get<1>(links[idx - 1]) == to)
+                continue; // a parallel link of greater (or equal) weight
+            arcs.push_back(CsrGraph::Arc{to, std::get<2>(links[idx])});
+            offsets[from + 1]++;
+        }
+        for (int component = 0; component < component_count; component++)
+            offsets[component + 1] += offsets[component];
+
+        condensation = CsrGraph(std::move(offsets), std::move(arcs));
+    }
+
+    // Tarjan's algorithm, with the recursion unrolled onto an explicit stack of frames
+    void tarjan() {
+        struct Frame {
+            int node;
+            size_t cursor;
+        };
+
+        int node_count = graph.nodeCount();
+        int current_index = 0;
+        std::vector<int> indices(node_count, -1), lows(node_count), labels(node_count);
+        std::vector<char> on_stack(node_count, false);
+        std::vector<int> stack;
+        std::vector<Frame> frames;
+        frames.reserve(node_count);
+
+        for (int root = 0; root < node_count; root++) {
+            if (indices[root] != -1)
+                continue;
+
+            indices[root] = lows[root] = current_index++;
+            stack.push_back(root);
+            on_stack[root] = true;
+            frames.push_back(Frame{root, 0});
+
+            while (!frames.empty()) {
+                Frame& frame = frames.back();
+                auto const& edges = graph.edges(frame.node);
+                if (frame.cursor < edges.size()) {
+                    int to = edges[frame.cursor++].to;
+                    if (indices[to] == -1) {
+                        indices[to] = lows[to] = current_index++;
+                        stack.push_back(to);
+                        on_stack[to] = true;
+                        frames.push_back(Frame{to, 0});
+                    } else if (on_stack[to]) {
+                        lows[frame.node] = std::min(lows[frame.node], indices[to]);
+                    }
+                    continue;
+                }
+
+                int node = frame.node;
+                frames.pop_back();
+                if (lows[node] == indices[node]) {
+                    int member;
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        on_stack[member] = false;
+                        labels[member] = node;
+                    } while (member != node);
+                }
+                if (!frames.empty())
+                    lows[frames.back().node] = std::min(lows[frames.back().node], lows[node]);
+            }
+        }
+
+        finish(labels);
+    }
+
+    // Forward-backward decomposition followed by coloring (as in Slota et al.'s Multistep method):
+    //  1. trimming: a node without active predecessors or successors is a component on its own,
+    //  2. the component of a well-connected pivot is the intersection of the nodes it reaches
+    //     and the nodes reaching it, which usually peels off the giant component in one go,
+    //  3. the rest is colored by propagating the largest node id forward, so that every node
+    //     gets the largest id it can be reached from; the nodes of a color that can reach
+    //     the node of that id backwards (within the color) are one component.
+    // Every step is a parallel sweep over the nodes or over a frontier.
+    void forward_backward(ThreadPool& pool) {
+        int node_count = graph.nodeCount();
+        std::vector<int> labels(node_count, -1);
+        std::vector<char> active(node_count, true);
+        std::vector<std::vector<int>> found(pool.size());
+
+        auto collect = [&](std::vector<int>& into) {
+            into.clear();
+            for (std::vector<int>& nodes: found) {
+                into.insert(into.end(), nodes.begin(), nodes.end());
+                nodes.clear();
+            }
+        };
+
+        // 1. trimming
+        std::vector<int> trimmed;
+        pool.parallel_for(0, node_count, [&](size_t node, size_t worker) {
+            bool has_successor = false, has_predecessor = false;
+            for (WeightedEdge const& edge: graph.edges(node))
+                if (edge.to != static_cast<int>(node)) {
+                    has_successor = true;
+                    break;
+                }
+            for (WeightedEdge const& rev_edge: graph.reverse_edges(node))
+                if (rev_edge.to != static_cast<int>(node)) {
+                    has_predecessor = true;
+                    break;
+                }
+            if (!has_successor || !has_predecessor)
+                found[worker].push_back(node);
+        }, 1024);
+        collect(trimmed);
+        for (int node: trimmed) {
+            labels[node] = node;
+            active[node] = false;
+        }
+
+        // 2. forward-backward from the pivot
+        int pivot = -1;
+        long long best_degree = -1;
+        for (int node = 0; node < node_count; node++) {
+            if (!active[node])
+                continue;
+            long long degree = static_cast<long long>(graph.edges(node).size()) * graph.reverse_edges(node).size();
+            if (degree > best_degree) {
+                best_degree = degree;
+                pivot = node;
+            }
+        }
+        if (pivot != -1) {
+            std::vector<std::atomic<char>> reached_forward(node_count), reached_backward(node_count);
+            pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+                reached_forward[node].store(false, std::memory_order_relaxed);
+                reached_backward[node].store(false, std::memory_order_relaxed);
+            }, 4096);
+
+            auto reach = [&](std::vector<std::atomic<char>>& reached, bool backward) {
+                std::vector<int> frontier{pivot}, next;
+                reached[pivot].store(true, std::memory_order_relaxed);
+                while (!frontier.empty()) {
+                    pool.parallel_for(0, frontier.size(), [&](size_t idx, size_t worker) {
+                        auto visit = [&](int to) {
+                            char unreached = false;
+                            if (active[to] && !reached[to].load(std::memory_order_relaxed) &&
+                                reached[to].compare_exchange_strong(unreached, true, std::memory_order_relaxed))
+                                found[worker].push_back(to);
+                        };
+                        if (backward) {
+                            for (WeightedEdge const& rev_edge: graph.reverse_edges(frontier[idx]))
+                                visit(rev_edge.to);
+                        } else {
+                            for (WeightedEdge const& edge: graph.edges(frontier[idx]))
+                                visit(edge.to);
+                        }
+                    }, 64);
+                    collect(next);
+                    frontier.swap(next);
+                }
+            };
+            reach(reached_forward, false);
+            reach(reached_backward, true);
+
+            pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+                if (reached_forward[node].load(std::memory_order_relaxed) &&
+                    reached_backward[node].load(std::memory_order_relaxed)) {
+                    labels[node] = pivot;
+                    active[node] = false;
+                }
+            }, 4096);
+        }
+
+        // 3. coloring, until every node is assigned to a component
+        std::vector<std::atomic<int>> colors(node_count);
+        std::vector<std::atomic<char>> queued(node_count);
+        std::vector<int> frontier, next;
+        while (true) {
+            frontier.clear();
+            for (int node = 0; node < node_count; node++) {
+                if (active[node]) {
+                    colors[node].store(node, std::memory_order_relaxed);
+                    queued[node].store(false, std::memory_order_relaxed);
+                    frontier.push_back(node);
+                }
+            }
+            if (frontier.empty())
+                break;
+
+            while (!frontier.empty()) {
+                pool.parallel_for(0, frontier.size(), [&](size_t idx, size_t worker) {
+                    int node = frontier[idx];
+                    int color = colors[node].load(std::memory_order_relaxed);
+                    for (WeightedEdge const& edge: graph.edges(node)) {
+                        if (!active[edge.to])
+                            continue;
+                        int current = colors[edge.to].load(std::memory_order_relaxed);
+                        bool raised = false;
+                        while (color > current)
+                            if (colors[edge.to].compare_exchange_weak(current, color, std::memory_order_relaxed))
+                                raised = true;
+                        char unqueued = false;
+                        if (raised && queued[edge.to].compare_exchange_strong(unqueued, true, std::memory_order_relaxed))
+                            found[worker].push_back(edge.to);
+                    }
+                }, 64);
+                collect(next);
+                for (int node: next)
+                    queued[node].store(false, std::memory_order_relaxed);
+                frontier.swap(next);
+            }
+
+            // every root (a node keeping its own id as color) gathers its component backwards
+            frontier.clear();
+            for (int node = 0; node < node_count; node++) {
+                if (active[node] && colors[node].load(std::memory_order_relaxed) == node) {
+                    labels[node] = node;
+                    frontier.push_back(node);
+                }
+            }
+            while (!frontier.empty()) {
+                pool.parallel_for(0, frontier.size(), [&](size_t idx, size_t worker) {
+                    int color = labels[frontier[idx]];
+                    for (WeightedEdge const& rev_edge: graph.reverse_edges(frontier[idx])) {
+                        int from = rev_edge.to;
+                        int same_color = color;
+                        // claiming a node flips its color to -1 - color, so it's only taken once
+                        if (active[from] && colors[from].load(std::memory_order_relaxed) == color &&
+                            colors[from].compare_exchange_strong(same_color, -1 - color, std::memory_order_relaxed))
+                            found[worker].push_back(from);
+                    }
+                }, 64);
+                collect(next);
+                for (int node: next)
+                    labels[node] = -1 - colors[node].load(std::memory_order_relaxed); // i.e. the color it had
+                frontier.swap(next);
+            }
+
+            for (int node = 0; node < node_count; node++)
+                if (active[node] && labels[node] != -1)
+                    active[node] = false;
+        }
+
+        finish(labels);
+    }
+
+public:
+    std::vector<int> const& getComponents() const { return components; }
+
+    int getComponentCount() const { return component_count; }
+
+    CsrGraph const& getCondensation() const { return condensation; }
+
+    static SccInfo tarjan(G const& graph) {
+        SccInfo scc_info(graph);
+        scc_info.tarjan();
+        return scc_info;
+    }
+
+    static SccInfo forward_backward(G const& graph, ThreadPool& pool) {
+        SccInfo scc_info(graph);
+        scc_info.forward_backward(pool);
+        return scc_info;
+    }
+};
+
+#endif //PLAYGROUND_STRONGLYCONNECTEDCOMPONENTS_HPP
@@ -0,0 +1,123 @@
+#ifndef PLAYGROUND_TEXTGRAPHPARSER_HPP
+#define PLAYGROUND_TEXTGRAPHPARSER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+
+// A fast reader of the text format of operator>>, bypassing iostreams entirely.
+//
+// The records of the format can't be told apart without reading them from the very
+// beginning (a number may just as well be an edge count as a weight), so parsing is
+// done in two steps. First the buffer is cut into as many chunks as there are workers
+// (at whitespace, so that no number is split in half), and every chunk is scanned for
+// integers in parallel. Then a quick pass hops through the numbers from record to
+// record to find where each node starts, after which the arcs are copied in parallel.
+namespace text_graph {
+    inline bool is_space(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+    inline void scan_integers(const char* first, const char* last, std::vector<int>& numbers) {
+        while (true) {
+            while (first != last && is_space(*first))
+                first++;
+            if (first == last)
+                return;
+
+            int number;
+            std::from_chars_result result = std::from_chars(first, last, number);
+            if (result.ec != std::errc() || (result.ptr != last && !is_space(*result.ptr)))
+                throw std::runtime_error("Malformed graph: expected an integer");
+            numbers.push_back(number);
+            first = result.ptr;
+        }
+    }
+}
+
+// Parses a graph from [first, last). The numbers following the graph (if any) are put into rest.
+inline CsrGraph parse_text_graph(const char* first, const char* last, ThreadPool& pool,
+                                 std::vector<int>* rest = nullptr) {
+    size_t size = last - first;
+    size_t chunk_count = pool.size();
+
+    std::vector<size_t> bounds(chunk_count + 1, size);
+    bounds[0] = 0;
+    for (size_t chunk = 1; chunk < chunk_count; chunk++) {
+        size_t bound = size * chunk / chunk_count;
+        if (bound < bounds[chunk - 1])
+            bound = bounds[chunk - 1];
+        while (bound < size && !text_graph::is_space(first[bound]))
+            bound++;
+        bounds[chunk] = bound;
+    }
+
+    std::vector<std::vector<int>> chunks(chunk_count);
+    pool.run([&](size_t worker) {
+        chunks[worker].reserve((bounds[worker + 1] - bounds[worker]) / 2);
+        text_graph::scan_integers(first + bounds[worker], first + bounds[worker + 1], chunks[worker]);
+    });
+
+    std::vector<size_t> chunk_starts(chunk_count + 1, 0);
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+        chunk_starts[chunk + 1] = chunk_starts[chunk] + chunks[chunk].size();
+    std::vector<int> numbers(chunk_starts.back());
+    pool.parallel_for(0, chunk_count, [&](size_t chunk, size_t) {
+        std::copy(chunks[chunk].begin(), chunks[chunk].end(), numbers.begin() + chunk_starts[chunk]);
+        std::vector<int>().swap(chunks[chunk]);
+    }, 1);
+
+    if (numbers.empty() || numbers[0] < 0)
+        throw std::runtime_error("Malformed graph: missing node count");
+    int node_count = numbers[0];
+
+    // hopping from record to record: where the arcs of each node start among the numbers
+    std::vector<size_t> offsets(node_count + 1, 0);
+    std::vector<size_t> record_starts(node_count);
+    size_t position = 1;
+    for (int node = 0; node < node_count; node++) {
+        if (position >= numbers.size() || numbers[position] < 0)
+            throw std::runtime_error("Malformed graph: missing edge count");
+        size_t edge_count = numbers[position];
+        record_starts[node] = position + 1;
+        offsets[node + 1] = offsets[node] + edge_count;
+        position += 1 + 2 * edge_count;
+    }
+    if (position > numbers.size())
+        throw std::runtime_error("Malformed graph: missing edges");
+
+    std::vector<CsrGraph::Arc> arcs(offsets.back());
+    pool.parallel_for(0, node_count, [&](size_t node, size_t) {
+        const int* record = numbers.data() + record_starts[node];
+        for (size_t idx = offsets[node]; idx < offsets[node + 1]; idx++, record += 2) {
+            if (record[0] < 0 || record[0] >= node_count)
+                throw std::runtime_error("Malformed graph: edge to a non-existent node");
+            arcs[idx] = CsrGraph::Arc{record[0], record[1]};
+        }
+    }, 1024);
+
+    if (rest != nullptr)
+        rest->assign(numbers.begin() + position, numbers.end());
+
+    return CsrGraph(std::move(offsets), std::move(arcs));
+}
+
+// Reads the whole file into memory in one go, then parses it with parse_text_graph.
+inline CsrGraph load_text_graph(const std::string& path, ThreadPool& pool, std::vector<int>* rest = nullptr) {
+    std::ifstream is(path, std::ios::binary | std::ios::ate);
+    if (!is)
+        throw std::runtime_error("Couldn't open " + path);
+
+    std::vector<char> buffer(static_cast<size_t>(is.tellg()));
+    is.seekg(0);
+    if (!is.read(buffer.data(), buffer.size()))
+        throw std::runtime_error("Couldn't read " + path);
+
+    return parse_text_graph(buffer.data(), buffer.data() + buffer.size(), pool, rest);
+}
+
+#endif //PLAYGROUND_TEXTGRAPHPARSER_HPP
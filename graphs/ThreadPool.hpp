@@ -0,0 +1,131 @@
+#ifndef PLAYGROUND_THREADPOOL_HPP
+#define PLAYGROUND_THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads that run one job at a time, all of them working on it.
+// The calling thread takes part as worker 0, so a pool of size 1 spawns no threads
+// and simply runs everything sequentially. If a worker throws, the first exception
+// is rethrown on the calling thread once every worker has finished.
+class ThreadPool {
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+    std::function<void(size_t)> job;
+    std::exception_ptr failure;
+    size_t generation;
+    size_t running;
+    bool stopping;
+
+    void work(size_t worker) {
+        size_t seen_generation = 0;
+        while (true) {
+            std::function<void(size_t)>* current_job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                job_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+                if (stopping)
+                    return;
+                seen_generation = generation;
+                current_job = &job;
+            }
+
+            std::exception_ptr current_failure;
+            try {
+                (*current_job)(worker);
+            } catch (...) {
+                current_failure = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (current_failure && !failure)
+                failure = current_failure;
+            if (--running == 0)
+                job_done.notify_one();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency())
+            : generation(0), running(0), stopping(false) {
+        thread_count = std::max<size_t>(thread_count, 1);
+        for (size_t worker = 1; worker < thread_count; worker++)
+            threads.emplace_back(&ThreadPool::work, this, worker);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        job_ready.notify_all();
+        for (std::thread& thread: threads)
+            thread.join();
+    }
+
+    size_t size() const { return threads.size() + 1; }
+
+    // calls f(worker) on every worker of the pool, and returns when all of them are done
+    void run(std::function<void(size_t)> f) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = std::move(f);
+            running = threads.size();
+            generation++;
+        }
+        job_ready.notify_all();
+
+        std::exception_ptr own_failure;
+        try {
+            job(0);
+        } catch (...) {
+            own_failure = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        job_done.wait(lock, [&] { return running == 0; });
+
+        std::exception_ptr current_failure = own_failure ? own_failure : failure;
+        failure = nullptr;
+        if (current_failure)
+            std::rethrow_exception(current_failure);
+    }
+
+    // calls f(idx, worker) for every idx in [begin, end), handing out chunks of grain indices on demand
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, F&& f, size_t grain = 256) {
+        if (begin >= end)
+            return;
+        if (size() == 1 || end - begin <= grain) {
+            for (size_t idx = begin; idx < end; idx++)
+                f(idx, size_t(0));
+            return;
+        }
+
+        std::atomic<size_t> next(begin);
+        run([&](size_t worker) {
+            size_t first;
+            while ((first = next.fetch_add(grain, std::memory_order_relaxed)) < end) {
+                size_t last = std::min(first + grain, end);
+                for (size_t idx = first; idx < last; idx++)
+                    f(idx, worker);
+            }
+        });
+    }
+};
+
+#endif //PLAYGROUND_THREADPOOL_HPP
@@ -0,0 +1,150 @@
+#ifndef PLAYGROUND_VERTEXORDERING_HPP
+#define PLAYGROUND_VERTEXORDERING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "Graph.hpp"
+
+// A relabeling of the nodes of a graph, so that nodes visited together get ids (and
+// so memory) close to each other. The ids of the input are often arbitrary, which turns
+// every traversal into random accesses; after relabeling, neighbors tend to share cache
+// lines and pages.
+//
+// The orderings look at the graph as undirected (following both edges and reverse edges):
+//  - BFS order numbers the nodes in the order a BFS visits them,
+//  - degree order puts the nodes of the largest degree first, so the hubs that most edges
+//    lead to are packed together,
+//  - Reverse Cuthill-McKee is a BFS from a low degree node visiting the neighbors in
+//    increasing order of degree, reversed; it keeps the ids of the two ends of each edge
+//    close (that is, the bandwidth of the adjacency matrix low).
+//
+// permute() builds the relabeled graph, to_new() and to_original() move per-node results
+// (e.g. the distances of DijkstraInfo) between the two numberings.
+template<typename G = Graph>
+class VertexOrdering {
+private:
+    G const& graph;
+    std::vector<int> new_ids; // by original id
+    std::vector<int> old_ids; // by new id
+
+    explicit VertexOrdering(G const& graph) : graph(graph), new_ids(graph.nodeCount(), -1) {
+        old_ids.reserve(graph.nodeCount());
+    }
+
+    size_t degree(int node) const { return graph.edges(node).size() + graph.reverse_edges(node).size(); }
+
+    void number(int node) {
+        new_ids[node] = old_ids.size();
+        old_ids.push_back(node);
+    }
+
+    // numbers the nodes reachable from root (in the undirected sense) in BFS order, continuing old_ids
+    void bfs_from(int root, bool by_degree) {
+        std::vector<int> neighbors;
+        size_t head = old_ids.size();
+        number(root);
+        for (; head < old_ids.size(); head++) {
+            int node = old_ids[head];
+            neighbors.clear();
+            for (WeightedEdge const& edge: graph.edges(node))
+                if (new_ids[edge.to] == -1)
+                    neighbors.push_back(edge.to);
+            for (WeightedEdge const& rev_edge: graph.reverse_edges(node))
+                if (new_ids[rev_edge.to] == -1)
+                    neighbors.push_back(rev_edge.to);
+            if (by_degree)
+                std::stable_sort(neighbors.begin(), neighbors.end(),
+                                 [&](int a, int b) { return degree(a) < degree(b); });
+            for (int neighbor: neighbors)
+                if (new_ids[neighbor] == -1)
+                    number(neighbor);
+        }
+    }
+
+    void bfs_order() {
+        for (int root = 0; root < graph.nodeCount(); root++)
+            if (new_ids[root] == -1)
+                bfs_from(root, false);
+    }
+
+    void degree_order() {
+        std::vector<int> nodes(graph.nodeCount());
+        for (int node = 0; node < graph.nodeCount(); node++)
+            nodes[node] = node;
+        std::stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) { return degree(a) > degree(b); });
+        for (int node: nodes)
+            number(node);
+    }
+
+    void reverse_cuthill_mckee() {
+        // every component is started from its node of the smallest degree, a cheap stand-in for a peripheral one
+        std::vector<int> nodes(graph.nodeCount());
+        for (int node = 0; node < graph.nodeCount(); node++)
+            nodes[node] = node;
+        std::stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) { return degree(a) < degree(b); });
+        for (int root: nodes)
+            if (new_ids[root] == -1)
+                bfs_from(root, true);
+
+        std::reverse(old_ids.begin(), old_ids.end());
+        for (int new_id = 0; new_id < graph.nodeCount(); new_id++)
+            new_ids[old_ids[new_id]] = new_id;
+    }
+
+public:
+    std::vector<int> const& getNewIds() const { return new_ids; }
+
+    std::vector<int> const& getOldIds() const { return old_ids; }
+
+    // the graph with every node relabeled, the edges of each node keeping their order
+    Graph permute() const {
+        Graph permuted(graph.nodeCount());
+        std::vector<WeightedEdge> edges;
+        for (int new_id = 0; new_id < graph.nodeCount(); new_id++) {
+            edges.clear();
+            for (WeightedEdge const& edge: graph.edges(old_ids[new_id]))
+                edges.emplace_back(new_id, new_ids[edge.to], edge.weight);
+            permuted.add_edges(edges);
+        }
+        return permuted;
+    }
+
+    // per-node results of the original graph, rearranged to the new ids
+    template<typename T>
+    std::vector<T> to_new(std::vector<T> const& by_original_id) const {
+        std::vector<T> by_new_id(by_original_id.size());
+        for (size_t new_id = 0; new_id < by_new_id.size(); new_id++)
+            by_new_id[new_id] = by_original_id[old_ids[new_id]];
+        return by_new_id;
+    }
+
+    // per-node results of the permuted graph, rearranged to the original ids
+    template<typename T>
+    std::vector<T> to_original(std::vector<T> const& by_new_id) const {
+        std::vector<T> by_original_id(by_new_id.size());
+        for (size_t old_id = 0; old_id < by_original_id.size(); old_id++)
+            by_original_id[old_id] = by_new_id[new_ids[old_id]];
+        return by_original_id;
+    }
+
+    static VertexOrdering bfs_order(G const& graph) {
+        VertexOrdering ordering(graph);
+        ordering.bfs_order();
+        return ordering;
+    }
+
+    static VertexOrdering degree_order(G const& graph) {
+        VertexOrdering ordering(graph);
+        ordering.degree_order();
+        return ordering;
+    }
+
+    static VertexOrdering reverse_cuthill_mckee(G const& graph) {
+        VertexOrdering ordering(graph);
+        ordering.reverse_cuthill_mckee();
+        return ordering;
+    }
+};
+
+#endif //PLAYGROUND_VERTEXORDERING_HPP
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "GraphAlgorithms.hpp"
+#include "ContractionHierarchy.hpp"
+
+// Builds the contraction hierarchy of a graph in the text format (as read by operator>>)
+// and writes it out. The hierarchy is then read back and checked against DijkstraInfo:
+// the distances from a few sources to every node have to agree.
+//
+// usage: BuildHierarchy <text input> <hierarchy output>
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <text input> <hierarchy output>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream is(argv[1]);
+    CsrGraph g;
+    if (!(is >> g)) {
+        std::cerr << "Couldn't read a graph from " << argv[1] << std::endl;
+        return 1;
+    }
+
+    try {
+        auto begin = std::chrono::steady_clock::now();
+        ContractionHierarchy built = ContractionHierarchy::build(g);
+        double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        std::ofstream os(argv[2], std::ios::binary);
+        built.write(os);
+        os.close();
+        // shortcuts add edges, but merging parallel edges and dropping self-loops removes some
+        long long added = static_cast<long long>(built.edgeCount()) - static_cast<long long>(g.edgeCount());
+        std::cout << "Wrote " << g.nodeCount() << " nodes and " << built.edgeCount() << " edges (" << std::showpos
+                  << added << std::noshowpos << " compared to the graph) to " << argv[2] << " in " << build_ms
+                  << " ms" << std::endl;
+
+        std::ifstream hierarchy_is(argv[2], std::ios::binary);
+        ContractionHierarchy hierarchy = ContractionHierarchy::read(hierarchy_is);
+        ContractionHierarchyQuery query(hierarchy);
+
+        int source_count = std::min(g.nodeCount(), 10);
+        size_t query_count = 0;
+        double query_ms = 0;
+        for (int idx = 0; idx < source_count; idx++) {
+            int source = static_cast<int>(static_cast<long long>(idx) * g.nodeCount() / source_count);
+            std::vector<int> distances = DijkstraInfo<CsrGraph>::dijkstra_heap(g, source).getDistances();
+
+            begin = std::chrono::steady_clock::now();
+            for (int target = 0; target < g.nodeCount(); target++) {
+                int distance = query.distance(source, target);
+                if (distance != distances[target]) {
+                    std::cerr << "Mismatch from " << source << " to " << target << ": " << distance << " instead of "
+                              << distances[target] << std::endl;
+                    return 1;
+                }
+            }
+            query_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            query_count += g.nodeCount();
+        }
+        if (query_count > 0)
+            std::cout << "Checked " << query_count << " queries against Dijkstra, " << query_ms * 1000 / query_count
+                      << " us per query" << std::endl;
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
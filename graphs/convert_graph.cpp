@@ -0,0 +1,36 @@
+#include <fstream>
+#include <iostream>
+#include "CsrGraph.hpp"
+#include "BinaryGraph.hpp"
+
+// Converts a graph from the text format (as read by operator>>) to the binary one,
+// which MappedGraph can load without any parsing. The written file is validated once.
+//
+// usage: ConvertGraph <text input> <binary output>
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <text input> <binary output>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream is(argv[1]);
+    CsrGraph g;
+    if (!(is >> g)) {
+        std::cerr << "Couldn't read a graph from " << argv[1] << std::endl;
+        return 1;
+    }
+
+    try {
+        {
+            std::ofstream os(argv[2], std::ios::binary);
+            write_binary_graph(os, g);
+        }
+        MappedGraph(argv[2]).validate(); // reads back what has been written
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << g.nodeCount() << " nodes and " << g.edgeCount() << " edges to " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "Graph.hpp"
+#include "GraphAlgorithms.hpp"
+#include "MultiSourceBfs.hpp"
+#include "ThreadPool.hpp"
+
+// Compares MultiSourceBfsInfo::bfs with running BfsInfo::bfs from each source, on the first
+// sources of a graph in the text format. The distances of the two have to agree.
+//
+// usage: MultiSourceBfsBenchmark <text input> [source count] [thread count]
+
+namespace {
+    template<typename F>
+    double measure(F&& f) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <text input> [source count] [thread count]" << std::endl;
+        return 1;
+    }
+    std::ifstream is(argv[1]);
+    Graph g;
+    if (!(is >> g)) {
+        std::cerr << "Couldn't read a graph from " << argv[1] << std::endl;
+        return 1;
+    }
+    int source_count = std::min(argc > 2 ? std::atoi(argv[2]) : 256, g.nodeCount());
+    ThreadPool pool(argc > 3 ? std::strtoul(argv[3], nullptr, 10) : std::thread::hardware_concurrency());
+
+    std::vector<int> sources;
+    for (int idx = 0; idx < source_count; idx++)
+        sources.push_back(static_cast<int>(static_cast<long long>(idx) * g.nodeCount() / source_count));
+
+    std::vector<std::vector<int>> expected;
+    double bfs_ms = measure([&] {
+        for (int source: sources)
+            expected.push_back(BfsInfo<>::bfs(g, source).getDistances());
+    });
+
+    std::vector<std::vector<int>> distances;
+    double msbfs_ms = measure([&] {
+        distances = MultiSourceBfsInfo<>::bfs(g, sources, pool).getDistances();
+    });
+
+    std::cout << source_count << " sources:\tBFS " << bfs_ms << " ms,\tmulti-source BFS " << msbfs_ms << " ms ("
+              << pool.size() << " threads)" << std::endl;
+    if (distances != expected) {
+        std::cerr << "The distances differ from the ones of BfsInfo!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
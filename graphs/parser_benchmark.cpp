@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "TextGraphParser.hpp"
+
+// Compares loading a text graph file through operator>> with the parallel parser.
+//
+// usage: ParserBenchmark <text input> [thread count]
+
+namespace {
+    template<typename F>
+    double measure(F&& f) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <text input> [thread count]" << std::endl;
+        return 1;
+    }
+    std::string path = argv[1];
+    size_t thread_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if (thread_count == 0)
+        thread_count = 1;
+
+    size_t edge_count = 0;
+
+    double graph_ms = measure([&] {
+        std::ifstream is(path);
+        Graph g;
+        is >> g;
+        edge_count = 0;
+        for (int node = 0; node < g.nodeCount(); node++)
+            edge_count += g.edges(node).size();
+    });
+    std::cout << "operator>> into Graph:\t\t" << graph_ms << " ms (" << edge_count << " edges)" << std::endl;
+
+    double csr_ms = measure([&] {
+        std::ifstream is(path);
+        CsrGraph g;
+        is >> g;
+        edge_count = g.edgeCount();
+    });
+    std::cout << "operator>> into CsrGraph:\t" << csr_ms << " ms (" << edge_count << " edges)" << std::endl;
+
+    for (size_t threads = 1; threads <= thread_count; threads *= 2) {
+        ThreadPool sized_pool(threads);
+        double parser_ms = measure([&] {
+            CsrGraph g = load_text_graph(path, sized_pool);
+            edge_count = g.edgeCount();
+        });
+        std::cout << "load_text_graph, " << threads << " thread(s):\t" << parser_ms << " ms (" << edge_count
+                  << " edges)" << std::endl;
+    }
+
+    return 0;
+}
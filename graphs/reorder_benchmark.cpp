@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+#include "GraphAlgorithms.hpp"
+#include "VertexOrdering.hpp"
+
+// Compares traversals of a graph under different node orderings. The ids of the input are
+// shuffled first (as arbitrary ids would be), then the graph is relabeled by each ordering
+// and BfsInfo::bfs and DijkstraInfo::dijkstra_heap are run from the same sources on it.
+// The average id gap of the edges is shown as a measure of how local the ordering is.
+//
+// usage: ReorderBenchmark <text input> [source count]
+
+namespace {
+    template<typename F>
+    double measure(F&& f) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    double average_gap(Graph const& g) {
+        double gaps = 0;
+        size_t edge_count = 0;
+        for (int node = 0; node < g.nodeCount(); node++) {
+            for (WeightedEdge const& edge: g.edges(node)) {
+                gaps += std::abs(edge.to - edge.from);
+                edge_count++;
+            }
+        }
+        return edge_count == 0 ? 0 : gaps / edge_count;
+    }
+
+    // runs the traversals on g from the given sources (by the ids of g), returns the sums of the distances found
+    std::vector<long long> run(std::string const& name, Graph const& g, std::vector<int> const& sources) {
+        std::vector<long long> checksums;
+        double bfs_ms = measure([&] {
+            for (int source: sources) {
+                BfsInfo<> bfs = BfsInfo<>::bfs(g, source);
+                checksums.push_back(std::accumulate(bfs.getDistances().begin(), bfs.getDistances().end(), 0LL));
+            }
+        });
+        double dijkstra_ms = measure([&] {
+            for (int source: sources) {
+                DijkstraInfo<> dijkstra = DijkstraInfo<>::dijkstra_heap(g, source);
+                checksums.push_back(std::accumulate(dijkstra.getDistances().begin(), dijkstra.getDistances().end(), 0LL));
+            }
+        });
+
+        std::cout << name << ":\tgap " << average_gap(g) << ",\tBFS " << bfs_ms / sources.size() << " ms,\tDijkstra "
+                  << dijkstra_ms / sources.size() << " ms" << std::endl;
+        return checksums;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <text input> [source count]" << std::endl;
+        return 1;
+    }
+    std::ifstream is(argv[1]);
+    Graph input;
+    if (!(is >> input)) {
+        std::cerr << "Couldn't read a graph from " << argv[1] << std::endl;
+        return 1;
+    }
+    int node_count = input.nodeCount();
+    int source_count = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (node_count == 0 || source_count <= 0) {
+        std::cerr << "Nothing to traverse" << std::endl;
+        return 1;
+    }
+
+    std::mt19937 generator(42);
+    std::vector<int> shuffled_ids(node_count);
+    std::iota(shuffled_ids.begin(), shuffled_ids.end(), 0);
+    std::shuffle(shuffled_ids.begin(), shuffled_ids.end(), generator);
+    Graph shuffled(node_count);
+    std::vector<std::vector<WeightedEdge>> shuffled_edges(node_count);
+    for (int node = 0; node < node_count; node++)
+        for (WeightedEdge const& edge: input.edges(node))
+            shuffled_edges[shuffled_ids[node]].emplace_back(shuffled_ids[node], shuffled_ids[edge.to], edge.weight);
+    for (std::vector<WeightedEdge> const& edges: shuffled_edges)
+        shuffled.add_edges(edges);
+
+    std::vector<int> sources;
+    for (int idx = 0; idx < source_count; idx++)
+        sources.push_back(generator() % node_count);
+
+    std::vector<long long> expected = run("shuffled", shuffled, sources);
+
+    auto run_ordering = [&](std::string const& name, VertexOrdering<> const& ordering) {
+        Graph permuted;
+        double permute_ms = measure([&] { permuted = ordering.permute(); });
+        std::vector<int> permuted_sources;
+        for (int source: sources)
+            permuted_sources.push_back(ordering.getNewIds()[source]);
+        if (run(name + " (permuted in " + std::to_string(static_cast<int>(permute_ms)) + " ms)", permuted,
+                permuted_sources) != expected)
+            std::cerr << name << ": the distances differ from the ones of the shuffled graph!" << std::endl;
+    };
+    run_ordering("BFS order", VertexOrdering<>::bfs_order(shuffled));
+    run_ordering("degree order", VertexOrdering<>::degree_order(shuffled));
+    run_ordering("RCM", VertexOrdering<>::reverse_cuthill_mckee(shuffled));
+
+    return 0;
+}